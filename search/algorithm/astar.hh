@@ -0,0 +1,295 @@
+#ifndef SEARCH_ALGORITHM_ASTAR_HH_
+#define SEARCH_ALGORITHM_ASTAR_HH_
+
+#include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "search/algorithm/common.hh"
+#include "search/algorithm/heap.hh"
+#include "search/algorithm/workspace.hh"
+#include "search/graph/common.hh"
+
+namespace search {
+///
+/// @concept HeuristicConcept
+///
+/// A heuristic is called as `heuristic(node, target)` and returns an
+/// estimate of the remaining distance from `node` to `target` which can be
+/// converted into the graph `EdgeType`.
+///
+template <typename Heuristic, typename Graph>
+concept HeuristicConcept =
+  requires(const Heuristic& heuristic, const typename Graph::NodeType& node) {
+  { heuristic(node, node) } -> std::convertible_to<typename Graph::EdgeType>;
+};
+
+///
+/// @concept PotentialConcept
+///
+/// A potential is a heuristic already bound to a target, called with the
+/// dense index of a node.
+///
+template <typename Potential, typename Graph>
+concept PotentialConcept =
+  requires(const Potential& potential, typename Graph::IndexType index) {
+  { potential(index) } -> std::convertible_to<typename Graph::EdgeType>;
+};
+
+///
+/// @class  AStarWorkspace
+/// @tparam Graph       Template for the graph the workspace is sized for.
+/// @tparam HeapPolicy  Priority queue used to order the frontier.
+///
+/// A `DjikstraWorkspace` which also memoizes the potential of every node,
+/// so a search evaluates it at most once per node even when a node is
+/// improved again.  The estimates are stamped with their own generation
+/// counter, bumped by `Reset` like the labels.
+///
+template <typename Graph, typename HeapPolicy>
+class AStarWorkspace : public DjikstraWorkspace<Graph, HeapPolicy> {
+ public:
+  using Base      = DjikstraWorkspace<Graph, HeapPolicy>;
+  using EdgeType  = typename Base::EdgeType;
+  using IndexType = typename Base::IndexType;
+
+  ///
+  /// @param graph Graph the workspace will be used with.
+  ///
+  explicit AStarWorkspace(const Graph& graph)
+    : Base(graph),
+      estimates(graph.NodeCount())
+  {}
+
+  AStarWorkspace(AStarWorkspace&&) = default;
+
+  AStarWorkspace&
+  operator=(AStarWorkspace&&) = default;
+
+  ///
+  /// Invalidate every label and estimate, ahead of a new search.
+  ///
+  void
+  Reset() {
+    Base::Reset();
+    if (++generation == 0) {
+      for (auto& estimate: estimates)
+        estimate.stamp = 0;
+      generation = 1;
+    }
+  }
+
+  ///
+  /// @tparam Potential See `PotentialConcept`.
+  /// @param  index     Dense index of the node.
+  /// @param  potential Estimate of the remaining distance.
+  ///
+  /// Return `potential(index)`, evaluated at most once per search.
+  ///
+  template <typename Potential>
+  EdgeType
+  Estimate(IndexType index, const Potential& potential) {
+    assert(index < estimates.size());
+    Entry& entry = estimates[index];
+    if (entry.stamp != generation) {
+      entry.value = static_cast<EdgeType>(potential(index));
+      entry.stamp = generation;
+    }
+    return entry.value;
+  }
+
+ private:
+  struct Entry {
+    EdgeType      value;
+    std::uint32_t stamp = 0;
+  };
+
+  std::uint32_t      generation = 1;
+  std::vector<Entry> estimates;
+};
+
+///
+/// @class  BasicAStar
+/// @tparam HeapPolicy  Priority queue used to order the frontier, see
+///                     `DefaultHeapPolicy`.
+///
+/// Goal directed point to point shortest path.  Nodes are expanded in order
+/// of `distance + heuristic`, so only nodes which can lie on a path shorter
+/// than the answer are touched.
+///
+/// The heuristic must be admissible (never overestimate) for the result to
+/// be exact.  It does not need to be consistent: a node whose distance is
+/// improved after it was expanded is expanded again.  Because estimates may
+/// then decrease between pops, the default queue is a `DaryHeap` and never
+/// a monotone `RadixHeap`.
+///
+template <typename HeapPolicy = DaryHeapPolicy<4>>
+class BasicAStar {
+ public:
+  ///
+  /// Reusable search state for `graph`, see `AStarWorkspace`.
+  ///
+  template <typename Graph>
+  using Workspace = AStarWorkspace<Graph, HeapPolicy>;
+
+  /// @tparam Graph      Template for the graph.
+  /// @tparam Heuristic  See `HeuristicConcept`.
+  /// @tparam NodeType   Inferred.
+  /// @tparam EdgeType   Inferred.
+  ///
+  /// Return the shortest path from `source` to `target` along with its
+  /// length.  Each call allocates a workspace, see `SolveIndex`.
+  template <
+    typename Graph,
+    typename Heuristic,
+    typename NodeType = typename Graph::NodeType,
+    typename EdgeType = typename Graph::EdgeType
+  >
+  static ShortestPath<NodeType, EdgeType>
+  Solve(
+      const Graph& graph,
+      const typename Graph::NodeType& source,
+      const typename Graph::NodeType& target,
+      const Heuristic& heuristic
+  ) requires IndexedGraphConcept<Graph>
+          && HeuristicConcept<Heuristic, Graph> {
+    using IndexType = typename Graph::IndexType;
+
+    return SolveIndex(
+      graph,
+      graph.Index(source),
+      graph.Index(target),
+      [&](IndexType index) -> EdgeType {
+        return heuristic(graph.Node(index), target);
+      }
+    );
+  }
+
+  /// @tparam Graph      Template for the graph.
+  /// @tparam Heuristic  See `HeuristicConcept`.
+  /// @tparam NodeType   Inferred.
+  /// @tparam EdgeType   Inferred.
+  ///
+  /// Return the shortest path using a reusable workspace.  The heuristic is
+  /// evaluated at most once per node.
+  template <
+    typename Graph,
+    typename Heuristic,
+    typename NodeType = typename Graph::NodeType,
+    typename EdgeType = typename Graph::EdgeType
+  >
+  static ShortestPath<NodeType, EdgeType>
+  Solve(
+      const Graph& graph,
+      const typename Graph::NodeType& source,
+      const typename Graph::NodeType& target,
+      const Heuristic& heuristic,
+      Workspace<Graph>& workspace
+  ) requires IndexedGraphConcept<Graph>
+          && HeuristicConcept<Heuristic, Graph> {
+    using IndexType = typename Graph::IndexType;
+
+    return SolveIndex(
+      graph,
+      graph.Index(source),
+      graph.Index(target),
+      [&](IndexType index) -> EdgeType {
+        return heuristic(graph.Node(index), target);
+      },
+      workspace
+    );
+  }
+
+  /// @tparam Graph      Template for the graph.
+  /// @tparam Potential  See `PotentialConcept`.
+  /// @tparam NodeType   Inferred.
+  /// @tparam EdgeType   Inferred.
+  ///
+  /// Index level entry point for heuristics which are computed from node
+  /// indices rather than node values, such as landmark bounds.  This
+  /// allocates a fresh workspace, which costs `O(N)` per query whatever the
+  /// search touches, so repeated queries should pass a workspace instead.
+  template <
+    typename Graph,
+    typename Potential,
+    typename NodeType = typename Graph::NodeType,
+    typename EdgeType = typename Graph::EdgeType
+  >
+  static ShortestPath<NodeType, EdgeType>
+  SolveIndex(
+      const Graph& graph,
+      typename Graph::IndexType source_index,
+      typename Graph::IndexType target_index,
+      const Potential& potential
+  ) requires IndexedGraphConcept<Graph>
+          && PotentialConcept<Potential, Graph> {
+    Workspace<Graph> workspace(graph);
+    return SolveIndex(graph, source_index, target_index, potential, workspace);
+  }
+
+  /// @tparam Graph      Template for the graph.
+  /// @tparam Potential  See `PotentialConcept`.
+  /// @tparam NodeType   Inferred.
+  /// @tparam EdgeType   Inferred.
+  ///
+  /// Index level entry point using a reusable workspace.  The potential is
+  /// memoized in the workspace, so it is evaluated at most once per node.
+  template <
+    typename Graph,
+    typename Potential,
+    typename NodeType = typename Graph::NodeType,
+    typename EdgeType = typename Graph::EdgeType
+  >
+  static ShortestPath<NodeType, EdgeType>
+  SolveIndex(
+      const Graph& graph,
+      typename Graph::IndexType source_index,
+      typename Graph::IndexType target_index,
+      const Potential& potential,
+      Workspace<Graph>& workspace
+  ) requires IndexedGraphConcept<Graph>
+          && PotentialConcept<Potential, Graph> {
+    using IndexType = typename Graph::IndexType;
+    static_assert(HeapConcept<typename Workspace<Graph>::Heap>);
+    assert(workspace.NodeCount() == graph.NodeCount());
+
+    auto& heap = workspace.Queue();
+    workspace.Reset();
+
+    workspace.Start(source_index);
+    heap.Push(source_index, workspace.Estimate(source_index, potential));
+
+    // Nodes are not marked settled, an improved node is simply expanded
+    // again.
+    while (!heap.Empty()) {
+      const IndexType node_index = heap.Pop().index;
+      if (node_index == target_index)
+        break;
+
+      const EdgeType node_edge = workspace.Distance(node_index);
+
+      for (const auto& neigh: graph.IndexNeighbors(node_index)) {
+        const EdgeType new_edge = node_edge + neigh.edge;
+
+        if (workspace.Relax(neigh.index, new_edge, node_index))
+          heap.Push(neigh.index,
+                    EdgeType(new_edge + workspace.Estimate(neigh.index, potential)));
+      }
+    }
+
+    return workspace.Path(graph, target_index);
+  }
+};
+
+///
+/// @class AStar
+///
+/// Goal directed shortest path using a 4-ary indexed heap.
+///
+using AStar = BasicAStar<>;
+} // ns search
+
+#endif // SEARCH_ALGORITHM_ASTAR_HH_
@@ -1,10 +1,17 @@
 #ifndef SEARCH_ALGORITHM_BELLMAN_FORD_HH_
 #define SEARCH_ALGORITHM_BELLMAN_FORD_HH_
 
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <deque>
 #include <stdexcept>
+#include <vector>
 
+#include "search/graph/common.hh"
 #include "search/graph/neighbor_graph.hh"
 #include "search/matrix/dense.hh"
+#include "search/parallel/common.hh"
 
 namespace search {
 ///
@@ -20,6 +27,27 @@ class BellmanFordNegativeWeight : public std::runtime_error {
 };
 
 
+///
+/// @enum BellmanFordMethod
+/// How the Bellman Ford solver picks the edges to relax.
+///
+enum class BellmanFordMethod {
+  /// Relax every edge, for up to `N - 1` rounds, stopping early once a
+  /// round changes nothing.  A guaranteed `O(N E)` with a sequential scan of
+  /// the adjacency, and negative cycles are found by one final round.  The
+  /// default, and the choice for dense changes or adversarial weights.
+  ROUNDS = 1,
+  /// Only relax the out edges of nodes whose distance changed, kept in a
+  /// queue ordered by the SLF and LLL heuristics (SPFA).  Usually far fewer
+  /// relaxations on sparse graphs where few distances change at once, but
+  /// the worst case is no better than `ROUNDS` and access is random.  A
+  /// negative cycle is reported as soon as a label needs `N` edges.
+  QUEUE  = 2,
+  /// Relax a flat array of every edge in rounds, split across threads.  The
+  /// same bound as `ROUNDS`, for large graphs with threads to spare.
+  EDGES  = 3,
+};
+
 ///
 /// @class BellmanFord
 ///
@@ -27,39 +55,101 @@ class BellmanFordNegativeWeight : public std::runtime_error {
 ///
 class BellmanFord {
  public:
+  ///
+  /// @struct Spec
+  ///
+  /// Specification for the Bellman Ford solver.
+  ///
+  struct Spec {
+    /// See `BellmanFordMethod` for when each one is preferable.
+    BellmanFordMethod method = BellmanFordMethod::ROUNDS;
+    /// Number of threads for `BellmanFordMethod::EDGES`, 0 means "all of
+    /// them".
+    std::size_t threads = 1;
+  };
+
+  /// @tparam record     Set to `Record::PREDECESSORS` to also store the
+  ///                    shortest path tree.
   /// @tparam Graph      Template for the graph.
   /// @tparam MatrixType This only needs to be overriden if you want sparse.
   /// @tparam NodeType   Inferred.
   /// @tparam EdgeType   Inferred.
   template <
+    Record   record     = Record::DISTANCES,
     typename Graph,
     typename MatrixType = DenseMatrix<typename Graph::EdgeType>,
     typename NodeType = typename Graph::NodeType,
     typename EdgeType = typename Graph::EdgeType
   >
-  static NeighborGraphSolution<NodeType, MatrixType>
-  Solve(const Graph& graph, const typename Graph::NodeType& start) {
-    MatrixType matrix(
-        1,
-        graph.NodeCount(),
+  static NeighborGraphSolution<NodeType, MatrixType, record>
+  Solve(const Graph& graph, const typename Graph::NodeType& start, Spec spec = {})
+    requires IndexedGraphConcept<Graph> {
+    NeighborGraphSolution<NodeType, MatrixType, record> solution(
+        graph.BuildNodeMap(),
+        false,
         graph.DefaultValue()
     );
-    auto node_map = graph.BuildNodeMap();
-    matrix.At(0, node_map[start]) = 0;
+
+    switch (spec.method) {
+      case BellmanFordMethod::ROUNDS:
+        ImplRounds(graph, graph.Index(start), solution);
+        break;
+      case BellmanFordMethod::QUEUE:
+        ImplQueue(graph, graph.Index(start), solution);
+        break;
+      case BellmanFordMethod::EDGES:
+        ImplEdges(graph, graph.Index(start), solution, spec.threads);
+        break;
+    }
+
+    return solution;
+  }
+
+  /// @tparam Graph    Template for the graph.
+  /// @tparam EdgeType Inferred.
+  ///
+  /// Return, by dense index, the distance to every node from a virtual
+  /// source joined to each node by a zero edge.  These are the potentials
+  /// `h` for which `edge + h(fr) - h(to)` is never negative, as used by
+  /// `Johnson`.  Throws `BellmanFordNegativeWeight` on any negative cycle.
+  template <
+    typename Graph,
+    typename EdgeType = typename Graph::EdgeType
+  >
+  static std::vector<EdgeType>
+  Potentials(const Graph& graph)
+    requires IndexedGraphConcept<Graph> {
+    std::vector<EdgeType> dist(graph.NodeCount(), EdgeType(0));
+    ImplQueue(graph, dist, [](auto, auto) {});
+    return dist;
+  }
+
+ private:
+  ///
+  /// Relax every edge until nothing changes, then look for an edge which
+  /// still relaxes.
+  ///
+  template <typename Graph, typename Solution>
+  static void
+  ImplRounds(const Graph& graph, typename Graph::IndexType start, Solution& solution) {
+    using IndexType = typename Graph::IndexType;
+
+    auto& matrix = solution.Edges();
+    matrix.At(0, start) = 0;
 
     for (std::size_t i = 1; i < graph.NodeCount(); ++i) {
       bool changes = false;
 
       // Iterate all edges.
-      for (const auto& node: graph.Nodes()) {
-        std::size_t idx_fr = node_map[node];
-
-        for (const auto& neigh: graph.Neighbors(node)) {
-          std::size_t idx_to = node_map[neigh.node];
+      for (IndexType idx_fr = 0; idx_fr < graph.NodeCount(); ++idx_fr) {
+        for (const auto& neigh: graph.IndexNeighbors(idx_fr)) {
+          const std::size_t idx_to = neigh.index;
 
           if (matrix.At(0, idx_fr) != graph.DefaultValue()
            && matrix.At(0, idx_fr) + neigh.edge < matrix.At(0, idx_to)) {
             matrix.At(0, idx_to) = matrix.At(0, idx_fr) + neigh.edge;
+            if constexpr (Solution::kPredecessors)
+              solution.Predecessors().At(0, idx_to) = idx_fr;
             changes = true;
           }
         }
@@ -70,11 +160,9 @@ class BellmanFord {
     }
 
     // Test for negative-weight cycles.
-    for (const auto& node: graph.Nodes()) {
-      std::size_t idx_fr = node_map[node];
-
-      for (const auto& neigh: graph.Neighbors(node)) {
-        std::size_t idx_to = node_map[neigh.node];
+    for (IndexType idx_fr = 0; idx_fr < graph.NodeCount(); ++idx_fr) {
+      for (const auto& neigh: graph.IndexNeighbors(idx_fr)) {
+        const std::size_t idx_to = neigh.index;
 
         if (matrix.At(0, idx_fr) != graph.DefaultValue()
          && matrix.At(0, idx_fr) + neigh.edge < matrix.At(0, idx_to)) {
@@ -82,11 +170,215 @@ class BellmanFord {
         }
       }
     }
+  }
 
-    return NeighborGraphSolution<NodeType, MatrixType>(
-        std::move(node_map),
-        std::move(matrix)
-    );
+  ///
+  /// SPFA from `start` into a solution, see the overload below.
+  ///
+  template <typename Graph, typename Solution>
+  static void
+  ImplQueue(const Graph& graph, typename Graph::IndexType start, Solution& solution) {
+    using IndexType = typename Graph::IndexType;
+    using EdgeType  = typename Graph::EdgeType;
+
+    const std::size_t count = graph.NodeCount();
+
+    std::vector<EdgeType> dist(count, graph.DefaultValue());
+    dist[start] = 0;
+
+    ImplQueue(graph, dist, [&](IndexType idx_fr, IndexType idx_to) {
+      if constexpr (Solution::kPredecessors)
+        solution.Predecessors().At(0, idx_to) = idx_fr;
+    });
+
+    auto& matrix = solution.Edges();
+    for (IndexType idx = 0; idx < count; ++idx)
+      if (dist[idx] != graph.DefaultValue())
+        matrix.At(0, idx) = dist[idx];
+  }
+
+  ///
+  /// SPFA from every node `dist` already labels, calling `relax(fr, to)`
+  /// each time the label of `to` drops.  A node is queued when its
+  /// distance drops and is not queued already.  Small label first puts it
+  /// at the front if it beats the current front, and large label last
+  /// rotates the front to the back while it is above the queue average.
+  ///
+  /// Every label records the number of edges of the walk it came from.
+  /// Labels only ever drop, so a walk which repeats a node went around a
+  /// negative cycle, and one of `N` or more edges must repeat a node.
+  ///
+  template <typename Graph, typename Relax>
+  static void
+  ImplQueue(const Graph& graph, std::vector<typename Graph::EdgeType>& dist, Relax&& relax) {
+    using IndexType = typename Graph::IndexType;
+    using EdgeType  = typename Graph::EdgeType;
+
+    const std::size_t count = graph.NodeCount();
+
+    std::vector<std::size_t> hops(count, 0);
+    std::vector<bool>        queued(count, false);
+    std::deque<IndexType>    queue;
+    double                   sum = 0;
+
+    for (IndexType idx = 0; idx < count; ++idx) {
+      if (dist[idx] == graph.DefaultValue())
+        continue;
+
+      queued[idx] = true;
+      queue.push_back(idx);
+      sum += double(dist[idx]);
+    }
+
+    while (!queue.empty()) {
+      // Large label last, bounded so rounding can not spin forever.
+      for (std::size_t n = queue.size(); n > 1; --n) {
+        if (double(dist[queue.front()]) * double(queue.size()) <= sum)
+          break;
+        queue.push_back(queue.front());
+        queue.pop_front();
+      }
+
+      const IndexType idx_fr = queue.front();
+      queue.pop_front();
+      queued[idx_fr] = false;
+      sum -= double(dist[idx_fr]);
+
+      for (const auto& neigh: graph.IndexNeighbors(idx_fr)) {
+        const IndexType idx_to   = neigh.index;
+        const EdgeType  new_edge = dist[idx_fr] + neigh.edge;
+
+        if (dist[idx_to] != graph.DefaultValue() && !(new_edge < dist[idx_to]))
+          continue;
+
+        hops[idx_to] = hops[idx_fr] + 1;
+        if (hops[idx_to] >= count)
+          throw BellmanFordNegativeWeight();
+
+        if (queued[idx_to]) {
+          sum -= double(dist[idx_to]) - double(new_edge);
+        } else {
+          queued[idx_to] = true;
+          sum += double(new_edge);
+
+          // Small label first.
+          if (!queue.empty() && new_edge < dist[queue.front()])
+            queue.push_front(idx_to);
+          else
+            queue.push_back(idx_to);
+        }
+
+        dist[idx_to] = new_edge;
+        relax(idx_fr, idx_to);
+      }
+    }
+  }
+
+  ///
+  /// Edge centric rounds.  Every edge is copied into one flat array, which
+  /// each round splits into a contiguous chunk per thread.  Distances are a
+  /// plain array lowered with `AtomicMin`, so a round may already see the
+  /// updates of the same round, which only speeds up convergence.  Without
+  /// a negative cycle nothing changes after `N - 1` rounds.
+  ///
+  template <typename Graph, typename Solution>
+  static void
+  ImplEdges(const Graph& graph, typename Graph::IndexType start, Solution& solution,
+            std::size_t requested) {
+    using IndexType = typename Graph::IndexType;
+    using EdgeType  = typename Graph::EdgeType;
+
+    struct Edge {
+      IndexType fr;
+      IndexType to;
+      EdgeType  edge;
+    };
+
+    const std::size_t count    = graph.NodeCount();
+    const EdgeType    sentinal = graph.DefaultValue();
+
+    // Sorted by `fr`, with `offsets` marking the out edges of each node.
+    std::vector<Edge>        edges;
+    std::vector<std::size_t> offsets(count + 1, 0);
+    for (IndexType idx_fr = 0; idx_fr < count; ++idx_fr) {
+      for (const auto& neigh: graph.IndexNeighbors(idx_fr))
+        edges.push_back({idx_fr, IndexType(neigh.index), neigh.edge});
+      offsets[idx_fr + 1] = edges.size();
+    }
+
+    std::vector<EdgeType> dist(count, sentinal);
+    dist[start] = 0;
+
+    const std::size_t threads =
+        std::min(ThreadCount(requested), std::max<std::size_t>(1, edges.size()));
+    std::atomic<bool> changes = true;
+    std::size_t       rounds  = 0;
+    bool              running = true;
+
+    // Runs once between rounds, after every thread has finished the last.
+    std::barrier sync(threads, [&]() noexcept {
+      running = changes.load() && rounds < count;
+      if (running) {
+        changes.store(false);
+        ++rounds;
+      }
+    });
+
+    ParallelRun(threads, [&](std::size_t thread) {
+      const std::size_t lo = edges.size() * thread / threads;
+      const std::size_t hi = edges.size() * (thread + 1) / threads;
+
+      while (true) {
+        sync.arrive_and_wait();
+        if (!running)
+          break;
+
+        bool local = false;
+        for (std::size_t n = lo; n < hi; ++n) {
+          const EdgeType fr_dist = AtomicLoad(dist[edges[n].fr]);
+          if (fr_dist == sentinal)
+            continue;
+
+          local |= AtomicMin(dist[edges[n].to], EdgeType(fr_dist + edges[n].edge));
+        }
+
+        if (local)
+          changes.store(true);
+      }
+    });
+
+    // The first `N - 1` rounds settle every distance, so a change in round
+    // `N` means a negative cycle.
+    if (changes.load())
+      throw BellmanFordNegativeWeight();
+
+    auto& matrix = solution.Edges();
+    for (IndexType idx = 0; idx < count; ++idx)
+      if (dist[idx] != sentinal)
+        matrix.At(0, idx) = dist[idx];
+
+    if constexpr (Solution::kPredecessors) {
+      // The last edge to lower a distance stays tight and was lowered
+      // earlier itself, so a search over tight edges from the start builds
+      // a tree.
+      auto& predecessors = solution.Predecessors();
+      std::vector<bool>      found(count, false);
+      std::vector<IndexType> order{start};
+      found[start] = true;
+
+      for (std::size_t n = 0; n < order.size(); ++n) {
+        const IndexType idx_fr = order[n];
+        for (std::size_t e = offsets[idx_fr]; e < offsets[idx_fr + 1]; ++e) {
+          const Edge& edge = edges[e];
+          if (found[edge.to] || !(dist[idx_fr] + edge.edge == dist[edge.to]))
+            continue;
+
+          found[edge.to] = true;
+          predecessors.At(0, edge.to) = idx_fr;
+          order.push_back(edge.to);
+        }
+      }
+    }
   }
 };
 } // ns search
@@ -1,10 +1,45 @@
 #ifndef SEARCH_ALGORITHM_COMMON_HH_
 #define SEARCH_ALGORITHM_COMMON_HH_
 
+#include <vector>
+
 #include "search/matrix/dense.hh"
 
 namespace search {
+///
+/// @struct ShortestPath
+/// @tparam NodeType  Type of the nodes on the path.
+/// @tparam EdgeType  Type of the path length.
+///
+/// Result of a point to point query.  `nodes` runs from the source to the
+/// target inclusive, and is empty if the target is unreachable in which case
+/// `distance` is the graph `DefaultValue()`.
+///
+template <typename NodeType, typename EdgeType>
+struct ShortestPath {
+  EdgeType              distance;
+  std::vector<NodeType> nodes;
+
+  /// True if the target was reached.
+  bool
+  Found() const {
+    return !nodes.empty();
+  }
+};
 
+///
+/// @struct NodeDistance
+/// @tparam NodeType  Type of the node.
+/// @tparam EdgeType  Type of the distance.
+///
+/// A node paired with its distance from the start of a search, the entries
+/// of the sparse results returned by bounded searches.
+///
+template <typename NodeType, typename EdgeType>
+struct NodeDistance {
+  NodeType node;
+  EdgeType distance;
+};
 } // ns search
 
 #endif // SEARCH_ALGORITHM_COMMON_HH_
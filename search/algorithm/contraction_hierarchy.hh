@@ -0,0 +1,769 @@
+#ifndef SEARCH_ALGORITHM_CONTRACTION_HIERARCHY_HH_
+#define SEARCH_ALGORITHM_CONTRACTION_HIERARCHY_HH_
+
+#include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "search/algorithm/common.hh"
+#include "search/algorithm/heap.hh"
+#include "search/graph/common.hh"
+#include "search/graph/mapped_neighbor_graph.hh"
+
+namespace search {
+///
+/// @class ContractionHierarchyError
+///
+/// Thrown when a serialized hierarchy cannot be written, read, or does not
+/// match the types of the `ContractionHierarchy` loading it.
+///
+class ContractionHierarchyError : public std::runtime_error {
+ public:
+  explicit ContractionHierarchyError(const std::string& what)
+    : std::runtime_error("ContractionHierarchyError: " + what) {}
+};
+
+///
+/// @struct ContractionHierarchyHeader
+///
+/// On-disk header of a serialized hierarchy.  The file is laid out as:
+///
+///   header | nodes[N] | rank[N] | up | down
+///
+/// where `up` and `down` are each `offsets[N + 1] | targets[E] |
+/// weights[E] | middles[E]`.  Values are stored in host byte order.
+///
+struct ContractionHierarchyHeader {
+  static constexpr char          kMagic[8] = {'S', 'R', 'C', 'H', 'C', 'H', 'R', 'C'};
+  static constexpr std::uint32_t kVersion  = 1;
+
+  char          magic[8];
+  std::uint32_t version;
+  std::uint32_t endian;
+  std::uint32_t node_tag;
+  std::uint32_t edge_tag;
+  std::uint64_t node_count;
+  std::uint64_t up_count;
+  std::uint64_t down_count;
+  std::uint64_t sentinal;
+};
+
+///
+/// @class  ContractionHierarchy
+/// @tparam NodeType_  What data type is being stored in the graph.
+/// @tparam EdgeType_  What data type is being stored in the edge.
+///
+/// A preprocessed graph answering point to point shortest path queries by
+/// searching only upward in a node hierarchy.
+///
+/// Preprocessing contracts nodes one at a time in order of edge difference
+/// (shortcuts added minus edges removed, plus the number of already
+/// contracted neighbors).  Contracting `v` adds a shortcut `u -> x` for
+/// every pair of neighbors unless a local witness search finds a path from
+/// `u` to `x` avoiding `v` which is no longer.  The order a node was
+/// contracted in is its rank.
+///
+/// Edges to higher ranked nodes are kept in an upward CSR, and edges from
+/// higher ranked nodes in a downward CSR.  A query runs Djikstra upward from
+/// the source and backward-upward from the target; the shortest path meets
+/// at its highest ranked node.  Each shortcut remembers the node it bypasses
+/// so paths unpack to original edges.
+///
+template <typename NodeType_, typename EdgeType_>
+class ContractionHierarchy {
+ public:
+  using NodeType   = NodeType_;
+  using EdgeType   = EdgeType_;
+  using IndexType  = std::uint32_t;
+  using OffsetType = std::uint64_t;
+  using NodeMap    = std::unordered_map<NodeType, std::size_t>;
+
+  ///
+  /// @struct Spec
+  ///
+  /// Specification for preprocessing a hierarchy.
+  ///
+  struct Spec {
+    /// Nodes a single witness search may settle, 0 is unbounded.  Smaller
+    /// limits preprocess faster but may add unnecessary shortcuts.
+    std::size_t witness_settles = 500;
+  };
+
+  ///
+  /// @class Workspace
+  ///
+  /// Scratch state for queries.  Only the entries touched by a query are
+  /// reset, so reusing one workspace makes a query cost proportional to the
+  /// search space rather than to the graph.  A workspace must not be shared
+  /// between threads.
+  ///
+  class Workspace {
+   public:
+    explicit Workspace(const ContractionHierarchy& hierarchy) {
+      const std::size_t count = hierarchy.NodeCount();
+      for (std::size_t side = 0; side < 2; ++side) {
+        dist[side].assign(count, hierarchy.DefaultValue());
+        parent[side].assign(count, kNone);
+        arc[side].assign(count, 0);
+        heap[side] = Heap(count);
+      }
+    }
+
+   private:
+    using Heap = DaryHeap<EdgeType, IndexType, 4>;
+
+    std::vector<EdgeType>   dist[2];
+    std::vector<IndexType>  parent[2];
+    std::vector<OffsetType> arc[2];
+    std::vector<IndexType>  touched[2];
+    Heap                    heap[2];
+
+    friend class ContractionHierarchy;
+  };
+
+  ///
+  /// @tparam Graph  Inferred.
+  /// @param  graph  Graph to preprocess.
+  /// @param  spec   See `Spec`.
+  ///
+  /// Contract every node of `graph`.  Directed graphs are supported, and
+  /// edge weights must be non-negative.
+  ///
+  template <typename Graph>
+  explicit ContractionHierarchy(const Graph& graph, Spec spec = {})
+    requires IndexedGraphConcept<Graph>
+          && std::same_as<typename Graph::NodeType, NodeType>
+          && std::same_as<typename Graph::EdgeType, EdgeType>
+    : sentinal(graph.DefaultValue()),
+      node_map(graph.BuildNodeMap())
+  {
+    assert(graph.NodeCount() < kNone);
+
+    nodes.reserve(graph.NodeCount());
+    for (IndexType idx = 0; idx < graph.NodeCount(); ++idx)
+      nodes.push_back(graph.Node(idx));
+
+    Contract(graph, spec);
+  }
+
+  ContractionHierarchy(ContractionHierarchy&&) = default;
+
+  ContractionHierarchy&
+  operator=(ContractionHierarchy&&) = default;
+
+  ///
+  /// @param path  Destination file.
+  ///
+  /// Serialize the hierarchy.  The file is written to a temporary name and
+  /// renamed into place.
+  ///
+  void
+  Save(const std::string& path) const requires MappableConcept<NodeType>
+                                            && MappableConcept<EdgeType> {
+    ContractionHierarchyHeader hdr = {};
+    std::memcpy(hdr.magic, ContractionHierarchyHeader::kMagic, sizeof(hdr.magic));
+    hdr.version    = ContractionHierarchyHeader::kVersion;
+    hdr.endian     = MappedGraphHeader::kEndian;
+    hdr.node_tag   = MappedGraphHeader::Tag<NodeType>();
+    hdr.edge_tag   = MappedGraphHeader::Tag<EdgeType>();
+    hdr.node_count = nodes.size();
+    hdr.up_count   = up.targets.size();
+    hdr.down_count = down.targets.size();
+    std::memcpy(&hdr.sentinal, &sentinal, sizeof(sentinal));
+
+    const std::string tmp_path = path + ".tmp";
+    std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+    if (!out)
+      throw ContractionHierarchyError("cannot create " + tmp_path);
+
+    // Never leave a partial temporary behind.
+    try {
+      auto emit = [&]<typename Type>(const std::vector<Type>& values) {
+        out.write(reinterpret_cast<const char*>(values.data()),
+                  values.size() * sizeof(Type));
+      };
+
+      out.write(reinterpret_cast<const char*>(&hdr), sizeof(hdr));
+      emit(nodes);
+      emit(rank);
+      for (const Csr* csr: {&up, &down}) {
+        emit(csr->offsets);
+        emit(csr->targets);
+        emit(csr->weights);
+        emit(csr->middles);
+      }
+
+      out.close();
+      if (!out)
+        throw ContractionHierarchyError("short write to " + tmp_path);
+
+      if (std::rename(tmp_path.c_str(), path.c_str()) != 0)
+        throw ContractionHierarchyError("cannot rename " + tmp_path + " to " + path);
+    } catch (...) {
+      out.close();
+      std::remove(tmp_path.c_str());
+      throw;
+    }
+  }
+
+  ///
+  /// @param path  File previously written by `Save`.
+  ///
+  /// Load a serialized hierarchy.
+  ///
+  static ContractionHierarchy
+  Load(const std::string& path) requires MappableConcept<NodeType>
+                                      && MappableConcept<EdgeType> {
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+      throw ContractionHierarchyError("cannot open " + path);
+
+    ContractionHierarchyHeader hdr;
+    if (!in.read(reinterpret_cast<char*>(&hdr), sizeof(hdr)))
+      throw ContractionHierarchyError("truncated header in " + path);
+
+    if (std::memcmp(hdr.magic, ContractionHierarchyHeader::kMagic,
+                    sizeof(hdr.magic)) != 0)
+      throw ContractionHierarchyError("bad magic in " + path);
+    if (hdr.version != ContractionHierarchyHeader::kVersion)
+      throw ContractionHierarchyError("unsupported version in " + path);
+    if (hdr.endian != MappedGraphHeader::kEndian)
+      throw ContractionHierarchyError("foreign byte order in " + path);
+    if (hdr.node_tag != MappedGraphHeader::Tag<NodeType>()
+     || hdr.edge_tag != MappedGraphHeader::Tag<EdgeType>())
+      throw ContractionHierarchyError("node/edge type mismatch in " + path);
+    if (hdr.node_count >= kNone)
+      throw ContractionHierarchyError("corrupt node count in " + path);
+
+    ContractionHierarchy hierarchy;
+    std::memcpy(&hierarchy.sentinal, &hdr.sentinal, sizeof(hierarchy.sentinal));
+
+    auto read = [&]<typename Type>(std::vector<Type>& values, std::uint64_t count) {
+      values.resize(count);
+      if (!in.read(reinterpret_cast<char*>(values.data()), count * sizeof(Type)))
+        throw ContractionHierarchyError("truncated section in " + path);
+    };
+
+    read(hierarchy.nodes, hdr.node_count);
+    read(hierarchy.rank,  hdr.node_count);
+    for (auto [csr, count]: {std::pair(&hierarchy.up,   hdr.up_count),
+                             std::pair(&hierarchy.down, hdr.down_count)}) {
+      read(csr->offsets, hdr.node_count + 1);
+      read(csr->targets, count);
+      read(csr->weights, count);
+      read(csr->middles, count);
+
+      if (csr->offsets.front() != 0 || csr->offsets.back() != count
+       || !std::is_sorted(csr->offsets.begin(), csr->offsets.end()))
+        throw ContractionHierarchyError("corrupt offsets in " + path);
+
+      for (std::size_t n = 0; n < count; ++n)
+        if (csr->targets[n] >= hdr.node_count
+         || (csr->middles[n] != kNone && csr->middles[n] >= hdr.node_count))
+          throw ContractionHierarchyError("corrupt arcs in " + path);
+    }
+
+    hierarchy.node_map.reserve(hierarchy.nodes.size());
+    for (std::size_t idx = 0; idx < hierarchy.nodes.size(); ++idx)
+      hierarchy.node_map.emplace(hierarchy.nodes[idx], idx);
+
+    return hierarchy;
+  }
+
+  ///
+  /// Return the default value, the distance reported for unreachable nodes.
+  ///
+  EdgeType
+  DefaultValue() const {
+    return sentinal;
+  }
+
+  ///
+  /// Return the number of unique nodes.
+  ///
+  std::size_t
+  NodeCount() const {
+    return nodes.size();
+  }
+
+  ///
+  /// Return the number of stored arcs which are shortcuts.
+  ///
+  std::size_t
+  ShortcutCount() const {
+    std::size_t count = 0;
+    for (const Csr* csr: {&up, &down})
+      for (const IndexType middle: csr->middles)
+        count += (middle != kNone);
+    return count;
+  }
+
+  ///
+  /// @param node Node to look up.
+  ///
+  /// Return the dense index of a node.
+  ///
+  IndexType
+  Index(const NodeType& node) const {
+    return node_map.at(node);
+  }
+
+  ///
+  /// @param index Dense index to look up.
+  ///
+  /// Return the node stored at a dense index.
+  ///
+  const NodeType&
+  Node(IndexType index) const {
+    assert(index < nodes.size());
+    return nodes[index];
+  }
+
+  ///
+  /// @param node Node to look up.
+  ///
+  /// Return the position at which a node was contracted.
+  ///
+  IndexType
+  Rank(const NodeType& node) const {
+    return rank[Index(node)];
+  }
+
+  ///
+  /// @param source     Start of the path.
+  /// @param target     End of the path.
+  /// @param workspace  Reusable query state.
+  ///
+  /// Return the shortest distance from `source` to `target`, or
+  /// `DefaultValue()` if it is unreachable.
+  ///
+  EdgeType
+  Distance(
+      const NodeType& source,
+      const NodeType& target,
+      Workspace& workspace
+  ) const {
+    return Search(Index(source), Index(target), workspace).first;
+  }
+
+  ///
+  /// Return the shortest distance using a temporary workspace.
+  ///
+  EdgeType
+  Distance(const NodeType& source, const NodeType& target) const {
+    Workspace workspace(*this);
+    return Distance(source, target, workspace);
+  }
+
+  ///
+  /// @param source     Start of the path.
+  /// @param target     End of the path.
+  /// @param workspace  Reusable query state.
+  ///
+  /// Return the shortest path from `source` to `target` with every shortcut
+  /// unpacked into original edges.
+  ///
+  ShortestPath<NodeType, EdgeType>
+  Path(
+      const NodeType& source,
+      const NodeType& target,
+      Workspace& workspace
+  ) const {
+    const auto [distance, meet] = Search(Index(source), Index(target), workspace);
+
+    ShortestPath<NodeType, EdgeType> path{distance, {}};
+    if (meet == kNone)
+      return path;
+
+    // Upward arcs from the source to the meeting node, collected backward.
+    std::vector<std::pair<IndexType, OffsetType>> upward;
+    for (IndexType v = meet; workspace.parent[0][v] != kNone;
+         v = workspace.parent[0][v])
+      upward.emplace_back(workspace.parent[0][v], workspace.arc[0][v]);
+
+    std::vector<IndexType> indices{Index(source)};
+    for (auto iter = upward.rbegin(); iter != upward.rend(); ++iter)
+      Unpack(iter->first, up.targets[iter->second], up.middles[iter->second],
+             indices);
+
+    // Downward arcs from the meeting node to the target.
+    for (IndexType v = meet; workspace.parent[1][v] != kNone;
+         v = workspace.parent[1][v])
+      Unpack(v, workspace.parent[1][v], down.middles[workspace.arc[1][v]],
+             indices);
+
+    path.nodes.reserve(indices.size());
+    for (const IndexType index: indices)
+      path.nodes.push_back(nodes[index]);
+
+    return path;
+  }
+
+  ///
+  /// Return the shortest path using a temporary workspace.
+  ///
+  ShortestPath<NodeType, EdgeType>
+  Path(const NodeType& source, const NodeType& target) const {
+    Workspace workspace(*this);
+    return Path(source, target, workspace);
+  }
+
+ private:
+  static constexpr IndexType kNone = std::numeric_limits<IndexType>::max();
+
+  ///
+  /// @struct Csr
+  ///
+  /// Arcs of one search direction.  `middles` holds the node a shortcut
+  /// bypasses, or `kNone` for an original edge.
+  ///
+  struct Csr {
+    std::vector<OffsetType> offsets;
+    std::vector<IndexType>  targets;
+    std::vector<EdgeType>   weights;
+    std::vector<IndexType>  middles;
+  };
+
+  ///
+  /// @struct Arc
+  ///
+  /// An edge of the graph being contracted.
+  ///
+  struct Arc {
+    IndexType index;
+    EdgeType  weight;
+    IndexType middle;
+  };
+
+  using ArcList = std::vector<Arc>;
+
+  EdgeType               sentinal;
+  std::vector<NodeType>  nodes;
+  NodeMap                node_map;
+  std::vector<IndexType> rank;
+  Csr                    up;
+  Csr                    down;
+
+  ContractionHierarchy() = default;
+
+  ///
+  /// Insert an arc, or lower the weight of an existing arc to the same node.
+  ///
+  static void
+  AddArc(ArcList& arcs, IndexType index, EdgeType weight, IndexType middle) {
+    for (auto& arc: arcs) {
+      if (arc.index == index) {
+        if (weight < arc.weight)
+          arc = {index, weight, middle};
+        return;
+      }
+    }
+    arcs.push_back({index, weight, middle});
+  }
+
+  ///
+  /// Remove the arc to `index`, if any.
+  ///
+  static void
+  RemoveArc(ArcList& arcs, IndexType index) {
+    for (auto& arc: arcs) {
+      if (arc.index == index) {
+        arc = arcs.back();
+        arcs.pop_back();
+        return;
+      }
+    }
+  }
+
+  ///
+  /// Compute the node order and the upward and downward arcs.
+  ///
+  template <typename Graph>
+  void
+  Contract(const Graph& graph, const Spec& spec) {
+    using Priority = std::int64_t;
+
+    const std::size_t count = nodes.size();
+
+    std::vector<ArcList> out(count);
+    std::vector<ArcList> in(count);
+    for (IndexType u = 0; u < count; ++u) {
+      for (const auto& neigh: graph.IndexNeighbors(u)) {
+        assert(!(neigh.edge < EdgeType(0)));
+        if (neigh.index == u)
+          continue;
+        AddArc(out[u], neigh.index, neigh.edge, kNone);
+        AddArc(in[neigh.index], u, neigh.edge, kNone);
+      }
+    }
+
+    std::vector<bool>      contracted(count, false);
+    std::vector<Priority>  deleted(count, 0);
+    std::vector<EdgeType>  witness(count, sentinal);
+    std::vector<IndexType> touched;
+    DaryHeap<EdgeType, IndexType, 4> heap(count);
+
+    // Djikstra from `source` avoiding `skip` and contracted nodes, giving up
+    // past `limit` or after `witness_settles` nodes.
+    auto witness_search = [&](IndexType source, IndexType skip, EdgeType limit) {
+      for (const IndexType index: touched)
+        witness[index] = sentinal;
+      touched.clear();
+      heap.Clear();
+
+      witness[source] = 0;
+      touched.push_back(source);
+      heap.Push(source, EdgeType(0));
+
+      std::size_t settles = 0;
+      while (!heap.Empty()) {
+        const auto [key, index] = heap.Pop();
+        if (limit < key)
+          break;
+        if (spec.witness_settles && ++settles > spec.witness_settles)
+          break;
+
+        for (const auto& arc: out[index]) {
+          if (arc.index == skip || contracted[arc.index])
+            continue;
+
+          const EdgeType new_edge = key + arc.weight;
+          if (new_edge < witness[arc.index]) {
+            if (witness[arc.index] == sentinal)
+              touched.push_back(arc.index);
+            witness[arc.index] = new_edge;
+            heap.Push(arc.index, new_edge);
+          }
+        }
+      }
+    };
+
+    // Call `emit(u, x, weight)` for every shortcut contracting `v` needs.
+    auto shortcuts = [&](IndexType v, auto&& emit) {
+      if (out[v].empty())
+        return;
+
+      EdgeType max_out = out[v].front().weight;
+      for (const auto& arc: out[v])
+        max_out = std::max(max_out, arc.weight);
+
+      for (const auto& arc_in: in[v]) {
+        witness_search(arc_in.index, v, arc_in.weight + max_out);
+
+        for (const auto& arc_out: out[v]) {
+          if (arc_out.index == arc_in.index)
+            continue;
+
+          const EdgeType weight = arc_in.weight + arc_out.weight;
+          if (!(witness[arc_out.index] <= weight))
+            emit(arc_in.index, arc_out.index, weight);
+        }
+      }
+    };
+
+    auto priority = [&](IndexType v) {
+      Priority added = 0;
+      shortcuts(v, [&](IndexType, IndexType, EdgeType) { ++added; });
+      return added - Priority(in[v].size() + out[v].size()) + deleted[v];
+    };
+
+    DaryHeap<Priority, IndexType, 4> queue(count);
+    for (IndexType v = 0; v < count; ++v)
+      queue.Push(v, priority(v));
+
+    std::vector<ArcList> up_arcs(count);
+    std::vector<ArcList> down_arcs(count);
+    std::vector<std::pair<std::pair<IndexType, IndexType>, EdgeType>> added;
+
+    rank.assign(count, 0);
+    IndexType next_rank = 0;
+
+    while (!queue.Empty()) {
+      const IndexType v = queue.Pop().index;
+
+      // Lazy update: contracting neighbors changes a priority, so recompute
+      // it and defer the node if it is no longer the smallest.
+      const Priority current = priority(v);
+      if (!queue.Empty() && queue.Top().key < current) {
+        queue.Push(v, current);
+        continue;
+      }
+
+      added.clear();
+      shortcuts(v, [&](IndexType u, IndexType x, EdgeType weight) {
+        added.push_back({{u, x}, weight});
+      });
+
+      rank[v]       = next_rank++;
+      contracted[v] = true;
+
+      for (const auto& arc: out[v]) {
+        RemoveArc(in[arc.index], v);
+        ++deleted[arc.index];
+      }
+      for (const auto& arc: in[v]) {
+        RemoveArc(out[arc.index], v);
+        ++deleted[arc.index];
+      }
+
+      for (const auto& [pair, weight]: added) {
+        AddArc(out[pair.first], pair.second, weight, v);
+        AddArc(in[pair.second], pair.first, weight, v);
+      }
+
+      // Every remaining neighbor is contracted later, so ranks higher.
+      up_arcs[v]   = std::move(out[v]);
+      down_arcs[v] = std::move(in[v]);
+      out[v].clear();
+      in[v].clear();
+    }
+
+    Freeze(up_arcs, up);
+    Freeze(down_arcs, down);
+  }
+
+  ///
+  /// Pack per node arc lists into a CSR.
+  ///
+  static void
+  Freeze(const std::vector<ArcList>& arcs, Csr& csr) {
+    csr.offsets.assign(1, 0);
+    for (const auto& list: arcs) {
+      for (const auto& arc: list) {
+        csr.targets.push_back(arc.index);
+        csr.weights.push_back(arc.weight);
+        csr.middles.push_back(arc.middle);
+      }
+      csr.offsets.push_back(csr.targets.size());
+    }
+  }
+
+  ///
+  /// Return the offset of the arc from `index` to `target` in `csr`.
+  ///
+  static OffsetType
+  FindArc(const Csr& csr, IndexType index, IndexType target) {
+    for (OffsetType n = csr.offsets[index]; n < csr.offsets[index + 1]; ++n)
+      if (csr.targets[n] == target)
+        return n;
+
+    assert(false && "shortcut references a missing arc");
+    return csr.offsets[index];
+  }
+
+  ///
+  /// Append the original nodes of the arc `from -> to` bypassing `middle`,
+  /// excluding `from`.
+  ///
+  void
+  Unpack(IndexType from, IndexType to, IndexType middle,
+         std::vector<IndexType>& indices) const {
+    struct Pending {
+      IndexType from;
+      IndexType to;
+      IndexType middle;
+    };
+
+    std::vector<Pending> stack{{from, to, middle}};
+    while (!stack.empty()) {
+      const Pending arc = stack.back();
+      stack.pop_back();
+
+      if (arc.middle == kNone) {
+        indices.push_back(arc.to);
+        continue;
+      }
+
+      // The bypassed node ranks below both ends: `from -> middle` is one of
+      // its downward arcs and `middle -> to` one of its upward arcs.
+      const OffsetType lower = FindArc(down, arc.middle, arc.from);
+      const OffsetType upper = FindArc(up,   arc.middle, arc.to);
+      stack.push_back({arc.middle, arc.to, up.middles[upper]});
+      stack.push_back({arc.from, arc.middle, down.middles[lower]});
+    }
+  }
+
+  ///
+  /// Run the bidirectional upward search, returning the distance and the
+  /// meeting node, or `kNone` if `target` is unreachable.
+  ///
+  std::pair<EdgeType, IndexType>
+  Search(IndexType source, IndexType target, Workspace& workspace) const {
+    for (std::size_t side = 0; side < 2; ++side) {
+      for (const IndexType index: workspace.touched[side]) {
+        workspace.dist[side][index]   = sentinal;
+        workspace.parent[side][index] = kNone;
+      }
+      workspace.touched[side].clear();
+      workspace.heap[side].Clear();
+    }
+
+    const IndexType start[2] = {source, target};
+    for (std::size_t side = 0; side < 2; ++side) {
+      workspace.dist[side][start[side]] = 0;
+      workspace.touched[side].push_back(start[side]);
+      workspace.heap[side].Push(start[side], EdgeType(0));
+    }
+
+    EdgeType  best = sentinal;
+    IndexType meet = kNone;
+
+    if (source == target)
+      return {EdgeType(0), source};
+
+    while (!workspace.heap[0].Empty() || !workspace.heap[1].Empty()) {
+      for (std::size_t side = 0; side < 2; ++side) {
+        auto& heap = workspace.heap[side];
+        if (heap.Empty())
+          continue;
+
+        // Nothing left on this side can improve the answer.
+        if (!(heap.Top().key < best)) {
+          heap.Clear();
+          continue;
+        }
+
+        const IndexType node_index = heap.Pop().index;
+        auto&           dist       = workspace.dist[side];
+        const EdgeType  node_edge  = dist[node_index];
+        const EdgeType  other      = workspace.dist[1 - side][node_index];
+
+        if (other != sentinal && node_edge + other < best) {
+          best = node_edge + other;
+          meet = node_index;
+        }
+
+        const Csr& csr = side == 0 ? up : down;
+        for (OffsetType n = csr.offsets[node_index];
+             n < csr.offsets[node_index + 1]; ++n) {
+          const IndexType neigh    = csr.targets[n];
+          const EdgeType  new_edge = node_edge + csr.weights[n];
+
+          if (new_edge < dist[neigh]) {
+            if (dist[neigh] == sentinal)
+              workspace.touched[side].push_back(neigh);
+            dist[neigh]                   = new_edge;
+            workspace.parent[side][neigh] = node_index;
+            workspace.arc[side][neigh]    = n;
+            heap.Push(neigh, new_edge);
+          }
+        }
+      }
+    }
+
+    return {best, meet};
+  }
+};
+} // ns search
+
+#endif // SEARCH_ALGORITHM_CONTRACTION_HIERARCHY_HH_
@@ -0,0 +1,298 @@
+#ifndef SEARCH_ALGORITHM_DELTA_STEPPING_HH_
+#define SEARCH_ALGORITHM_DELTA_STEPPING_HH_
+
+#include <algorithm>
+#include <barrier>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <exception>
+#include <type_traits>
+#include <vector>
+
+#include "search/graph/common.hh"
+#include "search/graph/neighbor_graph.hh"
+#include "search/matrix/dense.hh"
+#include "search/parallel/common.hh"
+
+namespace search {
+///
+/// @class DeltaStepping
+///
+/// Parallel single source shortest path for non-negative weights.
+///
+/// Tentative distances are kept in buckets of width `delta`.  The smallest
+/// non-empty bucket is drained by repeatedly relaxing the light edges
+/// (`weight <= delta`) of its nodes in parallel, then the heavy edges of
+/// every node removed from it are relaxed once, also in parallel.  Distances
+/// are lowered with an atomic min, so the result is exactly the one
+/// `Djikstra` computes.
+///
+class DeltaStepping {
+ public:
+  ///
+  /// @struct Spec
+  ///
+  /// Specification for a delta stepping solve.
+  ///
+  struct Spec {
+    /// Bucket width, 0 picks `max_weight / average_degree`.  Raised to at
+    /// least `max_weight / 65534` to bound the buckets.
+    double      delta   = 0;
+    /// Number of threads, 0 uses every hardware thread.
+    std::size_t threads = 1;
+  };
+
+  /// @tparam Graph      Template for the graph.
+  /// @tparam MatrixType This only needs to be overriden if you want sparse.
+  /// @tparam NodeType   Inferred.
+  /// @tparam EdgeType   Inferred.
+  ///
+  /// Solve the shortest path for a single starting node.
+  template <
+    typename Graph,
+    typename MatrixType = DenseMatrix<typename Graph::EdgeType>,
+    typename NodeType   = typename Graph::NodeType,
+    typename EdgeType   = typename Graph::EdgeType
+  >
+  static NeighborGraphSolution<NodeType, MatrixType>
+  Solve(
+      const Graph& graph,
+      const typename Graph::NodeType& start,
+      Spec spec = {}
+  ) requires IndexedGraphConcept<Graph> {
+    using IndexType = typename Graph::IndexType;
+
+    const std::size_t count    = graph.NodeCount();
+    const std::size_t threads  = ThreadCount(spec.threads);
+    const EdgeType    max_edge = MaxEdge(graph);
+    const EdgeType    delta    = Delta(graph, spec.delta, max_edge);
+
+    std::vector<EdgeType> dist(count, graph.DefaultValue());
+    auto bucket_of = [&](EdgeType value) -> std::size_t {
+      return static_cast<std::size_t>(value / delta);
+    };
+
+    // Every tentative distance lies within `max_edge` of the bucket being
+    // drained, so the buckets are a ring of `ceil(max_edge / delta) + 1`.
+    // It is sized with `bucket_of` itself, plus one for rounding, so the two
+    // agree for every `EdgeType`.
+    const std::size_t slots = bucket_of(max_edge) + 2;
+
+    // Buckets may hold stale entries; a node is only taken out of the bucket
+    // its current distance maps to, and only once per light phase.
+    std::vector<std::vector<IndexType>> buckets(slots);
+    std::vector<IndexType>              frontier;
+    std::vector<IndexType>              removed;
+    std::vector<IndexType>              deferred;
+    std::vector<std::uint64_t>          frontier_stamp(count, 0);
+    std::vector<std::uint64_t>          removed_stamp(count, 0);
+    std::vector<std::vector<IndexType>> improved(threads);
+    std::vector<std::exception_ptr>     errors(threads);
+
+    std::uint64_t phase   = 0;
+    std::size_t   current = 0;
+    bool          light   = true;
+    bool          done    = false;
+
+    const IndexType start_index = graph.Index(start);
+    dist[start_index] = 0;
+    buckets[0].push_back(start_index);
+
+    // Move improved nodes into their buckets, then pick the next frontier.
+    // This runs on a single thread between the parallel relaxations.
+    auto plan = [&]() {
+      for (auto& local: improved) {
+        for (const IndexType node: local)
+          buckets[bucket_of(dist[node]) % slots].push_back(node);
+        local.clear();
+      }
+
+      frontier.clear();
+      while (frontier.empty()) {
+        auto& bucket = buckets[current % slots];
+
+        if (light && !bucket.empty()) {
+          ++phase;
+          deferred.clear();
+          for (const IndexType node: bucket) {
+            const std::size_t index = bucket_of(dist[node]);
+            if (index > current) {
+              // A full turn of the ring ahead, only rounding gets here.  An
+              // entry for another slot is stale, the node is queued there.
+              if (index % slots == current % slots)
+                deferred.push_back(node);
+              continue;
+            }
+
+            if (index != current || frontier_stamp[node] == phase)
+              continue;
+
+            frontier_stamp[node] = phase;
+            frontier.push_back(node);
+
+            if (removed_stamp[node] != current + 1) {
+              removed_stamp[node] = current + 1;
+              removed.push_back(node);
+            }
+          }
+          bucket.swap(deferred);
+
+          if (!frontier.empty())
+            return;
+
+          // Every entry was stale or ahead, finish the bucket and move on.
+        }
+
+        if (light) {
+          // Bucket drained, relax the heavy edges of everything removed.
+          light = false;
+          frontier.swap(removed);
+          removed.clear();
+          if (!frontier.empty())
+            return;
+        }
+
+        light = true;
+
+        // A heavy edge whose sum rounded down may have landed back in the
+        // current bucket, drain it again before moving on.
+        if (std::any_of(bucket.begin(), bucket.end(), [&](IndexType node) {
+              return bucket_of(dist[node]) == current;
+            }))
+          continue;
+
+        // Advance to the next non-empty bucket, at most a full turn away.
+        std::size_t step = 1;
+        while (step <= slots && buckets[(current + step) % slots].empty())
+          ++step;
+
+        if (step > slots) {
+          done = true;
+          return;
+        }
+        current += step;
+      }
+    };
+
+    std::barrier sync(threads);
+    plan();
+
+    ParallelRun(threads, [&](std::size_t thread) {
+      while (true) {
+        sync.arrive_and_wait();
+        if (done)
+          break;
+
+        const std::size_t lo = frontier.size() * thread / threads;
+        const std::size_t hi = frontier.size() * (thread + 1) / threads;
+        auto& local = improved[thread];
+
+        try {
+          for (std::size_t n = lo; n < hi; ++n) {
+            const IndexType node      = frontier[n];
+            const EdgeType  node_edge = AtomicLoad(dist[node]);
+
+            for (const auto& neigh: graph.IndexNeighbors(node)) {
+              assert(neigh.edge >= EdgeType(0));
+              if ((neigh.edge <= delta) != light)
+                continue;
+
+              if (AtomicMin(dist[neigh.index], EdgeType(node_edge + neigh.edge)))
+                local.push_back(neigh.index);
+            }
+          }
+        } catch (...) {
+          errors[thread] = std::current_exception();
+        }
+
+        sync.arrive_and_wait();
+        if (thread == 0) {
+          // Stop every thread at the next barrier instead of leaving them
+          // waiting on one that is never reached.
+          bool failed = std::any_of(errors.begin(), errors.end(),
+                                    [](const auto& error) { return bool(error); });
+          if (!failed) {
+            try {
+              plan();
+            } catch (...) {
+              errors[thread] = std::current_exception();
+              failed = true;
+            }
+          }
+          if (failed)
+            done = true;
+        }
+      }
+    });
+
+    for (const auto& error: errors)
+      if (error)
+        std::rethrow_exception(error);
+
+    MatrixType matrix(1, count, graph.DefaultValue());
+    for (std::size_t idx = 0; idx < count; ++idx)
+      matrix.At(0, idx) = dist[idx];
+
+    return NeighborGraphSolution<NodeType, MatrixType>(
+        graph.BuildNodeMap(),
+        std::move(matrix)
+    );
+  }
+
+ private:
+  /// Largest number of buckets in the ring, about `max_edge / delta`.
+  static constexpr std::size_t kMaxBuckets = 1 << 16;
+
+  ///
+  /// Return the largest edge weight of the graph.
+  ///
+  template <typename Graph, typename EdgeType = typename Graph::EdgeType>
+  static EdgeType
+  MaxEdge(const Graph& graph) {
+    using IndexType = typename Graph::IndexType;
+
+    EdgeType max_edge = EdgeType(0);
+    for (IndexType idx = 0; idx < graph.NodeCount(); ++idx)
+      for (const auto& neigh: graph.IndexNeighbors(idx))
+        max_edge = std::max(max_edge, neigh.edge);
+
+    return max_edge;
+  }
+
+  ///
+  /// Resolve the bucket width, picking `max_edge / average_degree` if
+  /// requested.  A width too small for `kMaxBuckets` buckets to span
+  /// `max_edge` is raised to fit.
+  ///
+  template <typename Graph, typename EdgeType = typename Graph::EdgeType>
+  static EdgeType
+  Delta(const Graph& graph, double requested, EdgeType max_edge) {
+    using IndexType = typename Graph::IndexType;
+
+    double delta = requested;
+    if (delta <= 0) {
+      std::size_t edges = 0;
+      for (IndexType idx = 0; idx < graph.NodeCount(); ++idx)
+        for ([[maybe_unused]] const auto& neigh: graph.IndexNeighbors(idx))
+          ++edges;
+
+      const double degree = graph.NodeCount()
+                          ? double(edges) / graph.NodeCount()
+                          : 1.0;
+      delta = static_cast<double>(max_edge) / std::max(degree, 1.0);
+    }
+
+    // Bound the ring, whatever width was requested.
+    const double narrowest = static_cast<double>(max_edge) / double(kMaxBuckets - 2);
+    if (delta < narrowest)
+      delta = std::is_integral_v<EdgeType> ? std::ceil(narrowest) : narrowest;
+
+    // Integer weights need a width of at least one.
+    const EdgeType width = static_cast<EdgeType>(delta);
+    return width > EdgeType(0) ? width : EdgeType(1);
+  }
+};
+} // ns search
+
+#endif // SEARCH_ALGORITHM_DELTA_STEPPING_HH_
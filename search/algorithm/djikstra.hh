@@ -1,95 +1,178 @@
 #ifndef SEARCH_ALGORITHM_DJIKSTRA_HH_
 #define SEARCH_ALGORITHM_DJIKSTRA_HH_
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
-#include <iostream>
-#include <queue>
-#include <set>
-#include <unordered_map>
+#include <concepts>
+#include <limits>
+#include <mutex>
 #include <vector>
 
 #include "search/algorithm/common.hh"
+#include "search/algorithm/heap.hh"
+#include "search/algorithm/workspace.hh"
+#include "search/graph/common.hh"
 #include "search/graph/neighbor_graph.hh"
 #include "search/matrix/dense.hh"
+#include "search/matrix/fixed_point.hh"
+#include "search/parallel/common.hh"
 
 namespace search {
 ///
-/// @class Djikstra
+/// @class  BasicDjikstra
+/// @tparam HeapPolicy  Priority queue used to order the frontier, see
+///                     `DefaultHeapPolicy`.
 ///
-/// The classic shortest path algorithm.
+/// The classic shortest path algorithm.  Nodes are settled in order of
+/// distance using a heap over dense node indices.  Search state lives in a
+/// `DjikstraWorkspace`, which callers may keep across queries.
 ///
-class Djikstra {
+template <typename HeapPolicy = DefaultHeapPolicy>
+class BasicDjikstra {
+ public:
+  ///
+  /// Reusable search state for `graph`, see `DjikstraWorkspace`.
+  ///
+  template <typename Graph>
+  using Workspace = DjikstraWorkspace<Graph, HeapPolicy>;
+
  private:
+  template <typename Graph>
+  using Heap = typename HeapPolicy::template Heap<
+      typename Graph::EdgeType,
+      typename Graph::IndexType
+  >;
+
+  ///
+  /// Settle nodes from `start_index` until the heap runs dry, or until
+  /// `visit(index, distance)` called on a newly settled node returns false.
+  /// Nodes farther than `bound` are never labelled.  Labels are written to
+  /// `workspace`, which is reset first.
+  ///
   template <
     typename Graph,
-    bool all_pairs,
-    typename NodeType = typename Graph::NodeType,
-    typename EdgeType = typename Graph::EdgeType
+    typename Visit,
+    typename IndexType = typename Graph::IndexType,
+    typename EdgeType  = typename Graph::EdgeType
   >
   static void
   ImplSolve(
       const Graph& graph,
-      const std::unordered_map<NodeType, std::size_t>& node_map,
-      const NodeType& start,
-      DenseMatrix<EdgeType>& edges
+      IndexType start_index,
+      Workspace<Graph>& workspace,
+      Visit&& visit,
+      EdgeType bound
   ) {
-    // Get the index of the starting index.
-    std::size_t start_index = node_map.at(start);
+    static_assert(HeapConcept<Heap<Graph>>);
+    assert(workspace.NodeCount() == graph.NodeCount());
+
+    auto& heap = workspace.Queue();
+    workspace.Reset();
 
     // Initialize the self-loop.
-    if (all_pairs)
-      edges.At(start_index, start_index) = 0;
-    else
-      edges.At(0, start_index) = 0;
+    workspace.Start(start_index);
+    heap.Push(start_index, EdgeType(0));
 
-    // Initialize.
-    std::set<NodeType> observed;
-    using Pair = std::pair<EdgeType, NodeType>;
-    using PriorityQueue =
-        std::priority_queue<Pair, std::vector<Pair>, std::greater<Pair>>;
+    while (!heap.Empty()) {
+      const IndexType node_index = heap.Pop().index;
 
-    PriorityQueue pq;
-    pq.push({EdgeType(0), start});
+      if (!workspace.Settle(node_index))
+        continue;
 
-    while (!pq.empty()) {
-      Pair elem = pq.top();
-      pq.pop();
+      const EdgeType node_edge = workspace.Distance(node_index);
 
-      const auto& node = elem.second;
+      if (!visit(node_index, node_edge))
+        break;
 
-      if (observed.count(node))
-        continue;
-      else
-        observed.insert(node);
+      for (const auto& neigh: graph.IndexNeighbors(node_index)) {
+        if (workspace.Settled(neigh.index))
+          continue;
+
+        const EdgeType new_edge = node_edge + neigh.edge;
+        if (bound < new_edge)
+          continue;
 
-      std::size_t node_index = node_map.at(node);
+        if (workspace.Relax(neigh.index, new_edge, node_index))
+          heap.Push(neigh.index, new_edge);
+      }
+    }
+  }
 
-      for (const auto& neigh: graph.Neighbors(node)) {
-        EdgeType old_edge;
-        EdgeType new_edge;
+  ///
+  /// Settle every node reachable from `start_index`, or stop once
+  /// `target_index` is settled.
+  ///
+  template <
+    typename Graph,
+    typename IndexType = typename Graph::IndexType
+  >
+  static void
+  ImplSolve(
+      const Graph& graph,
+      IndexType start_index,
+      Workspace<Graph>& workspace,
+      IndexType target_index = std::numeric_limits<IndexType>::max()
+  ) {
+    ImplSolve(
+      graph,
+      start_index,
+      workspace,
+      [&](IndexType index, const auto&) { return index != target_index; },
+      graph.DefaultValue()
+    );
+  }
 
-        std::size_t neigh_index = node_map.at(neigh.node);
+  ///
+  /// True if every matrix `ImplStore` writes to has rows in disjoint memory,
+  /// so threads may store different rows concurrently.  Dense matrices do,
+  /// any other storage (such as a sparse map) shares state between rows.
+  ///
+  template <typename Solution>
+  static constexpr bool kDisjointRows =
+      requires(Solution& solution) { solution.Edges().Row(0); }
+   && (!Solution::kPredecessors
+    || requires(Solution& solution) { solution.Predecessors().Row(0); });
 
-        if (all_pairs) {
-          old_edge = edges.At(start_index, neigh_index);
-          new_edge = edges.At(start_index, node_index) + neigh.edge;
-        } else {
-          old_edge = edges.At(0, neigh_index);
-          new_edge = edges.At(0, node_index) + neigh.edge;
-        }
+  ///
+  /// Copy the distances of the last search into a row of a matrix,
+  /// converted to its element type with `StoreDistance`.
+  ///
+  template <typename Graph, typename Solution>
+  static void
+  ImplStore(
+      const Workspace<Graph>& workspace,
+      Solution& solution,
+      std::size_t row,
+      double scale = 1.0
+  ) {
+    using StoreType = typename Solution::EdgeType;
 
-        if (new_edge < old_edge) {
-          if (all_pairs)
-            edges.At(start_index, neigh_index) = new_edge;
-          else
-            edges.At(0, neigh_index) = new_edge;
+    for (std::size_t idx = 0; idx < workspace.NodeCount(); ++idx) {
+      if (!workspace.Reached(idx))
+        continue;
 
-          pq.push({new_edge, neigh.node});
-        }
-      }
+      solution.Edges().At(row, idx) = StoreDistance<StoreType>(workspace.Distance(idx), scale);
+      if constexpr (Solution::kPredecessors)
+        solution.Predecessors().At(row, idx) = workspace.Parent(idx);
     }
   }
+
  public:
+  ///
+  /// @struct Spec
+  ///
+  /// Specification for an all-pairs solve.
+  ///
+  struct Spec {
+    /// Number of threads, 0 uses every hardware thread.
+    std::size_t threads = 1;
+    /// Fixed point scale for unsigned storage, see `StoreDistance`.
+    double      scale   = 1.0;
+  };
+
+  /// @tparam record     Set to `Record::PREDECESSORS` to also store the
+  ///                    shortest path tree.
   /// @tparam Graph      Template for the graph.
   /// @tparam MatrixType This only needs to be overriden if you want sparse.
   /// @tparam NodeType   Inferred.
@@ -97,65 +180,406 @@ class Djikstra {
   ///
   /// Solve the shortest path for a single starting node.
   template <
+    Record   record     = Record::DISTANCES,
     typename Graph,
     typename MatrixType = DenseMatrix<typename Graph::EdgeType>,
     typename NodeType   = typename Graph::NodeType,
     typename EdgeType   = typename Graph::EdgeType
   >
-  static NeighborGraphSolution<NodeType, MatrixType>
-  Solve(const Graph& graph, const typename Graph::NodeType& start) {
-    using NodeMap = typename Graph::NodeMap;
-    NodeMap node_map = graph.BuildNodeMap();
-
-    NeighborGraphSolution<NodeType, MatrixType> solution(
-        std::move(node_map),
+  static NeighborGraphSolution<NodeType, MatrixType, record>
+  Solve(const Graph& graph, const typename Graph::NodeType& start)
+    requires IndexedGraphConcept<Graph> {
+    NeighborGraphSolution<NodeType, MatrixType, record> solution(
+        graph.BuildNodeMap(),
         false,
-        graph.DefaultValue()
-    );
-    ImplSolve<Graph, false>(
-      graph,
-      solution.Nodes(),
-      start,
-      solution.Edges()
+        StoreDistance<typename MatrixType::Type>(graph.DefaultValue(), 1.0)
     );
+    Workspace<Graph> workspace(graph);
+
+    ImplSolve(graph, graph.Index(start), workspace);
+    ImplStore(workspace, solution, 0);
 
     return solution;
   }
 
+  /// @tparam Graph      Template for the graph.
+  ///
+  /// Solve the shortest path for a single starting node into `workspace`,
+  /// which holds the distances and parents until its next use.  Nothing is
+  /// allocated.
+  template <typename Graph>
+  static void
+  Solve(
+      const Graph& graph,
+      const typename Graph::NodeType& start,
+      Workspace<Graph>& workspace
+  ) requires IndexedGraphConcept<Graph> {
+    ImplSolve(graph, graph.Index(start), workspace);
+  }
+
+  /// @tparam record     Set to `Record::PREDECESSORS` to also store every
+  ///                    shortest path tree.
   /// @tparam Graph      Template for the graph.
   /// @tparam MatrixType This only needs to be overriden if you want sparse.
   /// @tparam NodeType   Inferred.
   /// @tparam EdgeType   Inferred.
   ///
-  /// Solve the shortest path for all starting nodes.
+  /// Solve the shortest path for all starting nodes.  Sources are handed
+  /// out to `spec.threads` threads, each owning its own workspace and
+  /// writing only to the row of the source it is solving.  The matrix may
+  /// hold unsigned fixed point such as `DenseMatrix<uint16_t>`: searches
+  /// run in the graph's edge type and only the final distances are
+  /// rounded, saturating into the sentinal.
   template <
+    Record   record     = Record::DISTANCES,
     typename Graph,
     typename MatrixType = DenseMatrix<typename Graph::EdgeType>,
     typename NodeType   = typename Graph::NodeType,
     typename EdgeType   = typename Graph::EdgeType
   >
-  static NeighborGraphSolution<NodeType, MatrixType>
-  Solve(const Graph& graph) {
-    using NodeMap = typename Graph::NodeMap;
-    NodeMap node_map = graph.BuildNodeMap();
+  static NeighborGraphSolution<NodeType, MatrixType, record>
+  Solve(const Graph& graph, Spec spec = {})
+    requires IndexedGraphConcept<Graph> {
+    using IndexType = typename Graph::IndexType;
+    using Solution  = NeighborGraphSolution<NodeType, MatrixType, record>;
 
-    NeighborGraphSolution<NodeType, MatrixType> solution(
-        std::move(node_map),
+    Solution solution(
+        graph.BuildNodeMap(),
         true,
-        graph.DefaultValue()
+        StoreDistance<typename MatrixType::Type>(graph.DefaultValue(), spec.scale)
     );
 
-    for (const auto& node: node_map) {
-      ImplSolve<Graph, true>(
-        graph,
-        solution.Nodes(),
-        node.first,
-        solution.Edges()
-      );
-    }
+    const std::size_t count = graph.NodeCount();
+    std::atomic<std::size_t> next(0);
+
+    // Without disjoint rows, rows are stored one at a time.
+    std::mutex store;
+
+    ParallelRun(std::min(ThreadCount(spec.threads), std::max<std::size_t>(count, 1)),
+        [&](std::size_t) {
+          Workspace<Graph> workspace(graph);
+
+          for (std::size_t idx = next++; idx < count; idx = next++) {
+            ImplSolve(graph, static_cast<IndexType>(idx), workspace);
+            if constexpr (kDisjointRows<Solution>) {
+              ImplStore(workspace, solution, idx, spec.scale);
+            } else {
+              std::lock_guard lock(store);
+              ImplStore(workspace, solution, idx, spec.scale);
+            }
+          }
+        });
 
     return solution;
   }
+
+  /// @tparam Graph      Template for the graph.
+  /// @tparam EdgeType   Inferred.
+  ///
+  /// Return the shortest distance from `source` to `target`, or
+  /// `DefaultValue()` if it is unreachable.  The search stops as soon as
+  /// `target` is settled.
+  template <
+    typename Graph,
+    typename EdgeType = typename Graph::EdgeType
+  >
+  static EdgeType
+  Query(
+      const Graph& graph,
+      const typename Graph::NodeType& source,
+      const typename Graph::NodeType& target,
+      Workspace<Graph>& workspace
+  ) requires IndexedGraphConcept<Graph> {
+    const auto target_index = graph.Index(target);
+    ImplSolve(graph, graph.Index(source), workspace, target_index);
+    return workspace.Distance(target_index);
+  }
+
+  /// @tparam Graph      Template for the graph.
+  /// @tparam EdgeType   Inferred.
+  ///
+  /// Return the shortest distance using a temporary workspace.
+  template <
+    typename Graph,
+    typename EdgeType = typename Graph::EdgeType
+  >
+  static EdgeType
+  Query(
+      const Graph& graph,
+      const typename Graph::NodeType& source,
+      const typename Graph::NodeType& target
+  ) requires IndexedGraphConcept<Graph> {
+    Workspace<Graph> workspace(graph);
+    return Query(graph, source, target, workspace);
+  }
+
+  /// @tparam Graph      Template for the graph.
+  /// @tparam NodeType   Inferred.
+  /// @tparam EdgeType   Inferred.
+  ///
+  /// Return the shortest path from `source` to `target`, stopping as soon
+  /// as `target` is settled.
+  template <
+    typename Graph,
+    typename NodeType = typename Graph::NodeType,
+    typename EdgeType = typename Graph::EdgeType
+  >
+  static ShortestPath<NodeType, EdgeType>
+  Path(
+      const Graph& graph,
+      const typename Graph::NodeType& source,
+      const typename Graph::NodeType& target,
+      Workspace<Graph>& workspace
+  ) requires IndexedGraphConcept<Graph> {
+    const auto target_index = graph.Index(target);
+    ImplSolve(graph, graph.Index(source), workspace, target_index);
+    return workspace.Path(graph, target_index);
+  }
+
+  /// @tparam Graph      Template for the graph.
+  /// @tparam NodeType   Inferred.
+  /// @tparam EdgeType   Inferred.
+  ///
+  /// Return every node within `radius` of `start`, including `start`, in
+  /// order of distance.  Only the neighborhood inside the radius is
+  /// explored.
+  template <
+    typename Graph,
+    typename NodeType = typename Graph::NodeType,
+    typename EdgeType = typename Graph::EdgeType
+  >
+  static std::vector<NodeDistance<NodeType, EdgeType>>
+  SolveWithin(
+      const Graph& graph,
+      const typename Graph::NodeType& start,
+      EdgeType radius,
+      Workspace<Graph>& workspace
+  ) requires IndexedGraphConcept<Graph> {
+    using IndexType = typename Graph::IndexType;
+
+    std::vector<NodeDistance<NodeType, EdgeType>> result;
+    ImplSolve(
+      graph,
+      graph.Index(start),
+      workspace,
+      [&](IndexType index, EdgeType distance) {
+        result.push_back({graph.Node(index), distance});
+        return true;
+      },
+      radius
+    );
+
+    return result;
+  }
+
+  /// @tparam Graph      Template for the graph.
+  /// @tparam NodeType   Inferred.
+  /// @tparam EdgeType   Inferred.
+  ///
+  /// Return every node within `radius` using a temporary workspace.
+  template <
+    typename Graph,
+    typename NodeType = typename Graph::NodeType,
+    typename EdgeType = typename Graph::EdgeType
+  >
+  static std::vector<NodeDistance<NodeType, EdgeType>>
+  SolveWithin(
+      const Graph& graph,
+      const typename Graph::NodeType& start,
+      EdgeType radius
+  ) requires IndexedGraphConcept<Graph> {
+    Workspace<Graph> workspace(graph);
+    return SolveWithin(graph, start, radius, workspace);
+  }
+
+  /// @tparam Graph      Template for the graph.
+  /// @tparam Predicate  Called as `predicate(node)`, returns true for nodes
+  ///                    which should be reported.
+  /// @tparam NodeType   Inferred.
+  /// @tparam EdgeType   Inferred.
+  ///
+  /// Return the `k` nodes closest to `start` which satisfy `predicate`, in
+  /// order of distance.  `start` itself is reported if it satisfies
+  /// `predicate`.  The search stops as soon as `k` nodes are found.
+  template <
+    typename Graph,
+    typename Predicate,
+    typename NodeType = typename Graph::NodeType,
+    typename EdgeType = typename Graph::EdgeType
+  >
+  static std::vector<NodeDistance<NodeType, EdgeType>>
+  Nearest(
+      const Graph& graph,
+      const typename Graph::NodeType& start,
+      std::size_t k,
+      const Predicate& predicate,
+      Workspace<Graph>& workspace
+  ) requires IndexedGraphConcept<Graph>
+          && std::predicate<const Predicate&, const typename Graph::NodeType&> {
+    using IndexType = typename Graph::IndexType;
+
+    std::vector<NodeDistance<NodeType, EdgeType>> result;
+    if (k == 0)
+      return result;
+
+    ImplSolve(
+      graph,
+      graph.Index(start),
+      workspace,
+      [&](IndexType index, EdgeType distance) {
+        const auto& node = graph.Node(index);
+        if (predicate(node))
+          result.push_back({node, distance});
+        return result.size() < k;
+      },
+      graph.DefaultValue()
+    );
+
+    return result;
+  }
+
+  /// @tparam Graph      Template for the graph.
+  /// @tparam Predicate  Called as `predicate(node)`.
+  /// @tparam NodeType   Inferred.
+  /// @tparam EdgeType   Inferred.
+  ///
+  /// Return the `k` nearest matching nodes using a temporary workspace.
+  template <
+    typename Graph,
+    typename Predicate,
+    typename NodeType = typename Graph::NodeType,
+    typename EdgeType = typename Graph::EdgeType
+  >
+  static std::vector<NodeDistance<NodeType, EdgeType>>
+  Nearest(
+      const Graph& graph,
+      const typename Graph::NodeType& start,
+      std::size_t k,
+      const Predicate& predicate
+  ) requires IndexedGraphConcept<Graph>
+          && std::predicate<const Predicate&, const typename Graph::NodeType&> {
+    Workspace<Graph> workspace(graph);
+    return Nearest(graph, start, k, predicate, workspace);
+  }
+
+  /// @tparam Graph        Template for the graph.
+  /// @tparam ReverseGraph Template for the reversed graph.
+  /// @tparam EdgeType     Inferred.
+  ///
+  /// Return the shortest distance from `source` to `target` by searching
+  /// forward from `source` on `graph` and backward from `target` on
+  /// `reverse` until the two searches meet.  `reverse` must hold every edge
+  /// of `graph` transposed with the same node indices, see
+  /// `CompressedNeighborGraph::Reverse`; an undirected graph is its own
+  /// reverse.
+  template <
+    typename Graph,
+    typename ReverseGraph,
+    typename EdgeType = typename Graph::EdgeType
+  >
+  static EdgeType
+  BidirectionalQuery(
+      const Graph& graph,
+      const ReverseGraph& reverse,
+      const typename Graph::NodeType& source,
+      const typename Graph::NodeType& target,
+      Workspace<Graph>& forward,
+      Workspace<Graph>& backward
+  ) requires IndexedGraphConcept<Graph>
+          && IndexedGraphConcept<ReverseGraph> {
+    using IndexType = typename Graph::IndexType;
+
+    assert(graph.NodeCount() == reverse.NodeCount());
+
+    const EdgeType  sentinal = graph.DefaultValue();
+    const IndexType s        = graph.Index(source);
+    const IndexType t        = graph.Index(target);
+
+    if (s == t)
+      return EdgeType(0);
+
+    Workspace<Graph>* side_of[2] = {&forward, &backward};
+    EdgeType          last[2]    = {EdgeType(0), EdgeType(0)};
+
+    forward.Reset();
+    backward.Reset();
+    forward.Start(s);
+    backward.Start(t);
+    forward.Queue().Push(s, EdgeType(0));
+    backward.Queue().Push(t, EdgeType(0));
+
+    // Length of the best path found so far through a node labelled by both
+    // searches.
+    EdgeType best = sentinal;
+
+    auto step = [&](const auto& adjacency, std::size_t side) {
+      auto&       workspace  = *side_of[side];
+      const auto& other      = *side_of[1 - side];
+      const IndexType node_index = workspace.Queue().Pop().index;
+
+      if (!workspace.Settle(node_index))
+        return true;
+
+      // Every remaining path is at least as long as the two last settled
+      // distances combined.
+      last[side] = workspace.Distance(node_index);
+      if (!(last[0] + last[1] < best))
+        return false;
+
+      for (const auto& neigh: adjacency.IndexNeighbors(node_index)) {
+        const EdgeType new_edge = last[side] + neigh.edge;
+
+        if (workspace.Relax(neigh.index, new_edge, node_index))
+          workspace.Queue().Push(neigh.index, new_edge);
+
+        if (other.Reached(neigh.index)
+         && new_edge + other.Distance(neigh.index) < best)
+          best = new_edge + other.Distance(neigh.index);
+      }
+
+      return true;
+    };
+
+    while (!forward.Queue().Empty() && !backward.Queue().Empty()) {
+      const bool ahead = forward.Queue().Size() <= backward.Queue().Size();
+      const bool more  = ahead ? step(graph, 0) : step(reverse, 1);
+      if (!more)
+        break;
+    }
+
+    return best;
+  }
+
+  /// @tparam Graph        Template for the graph.
+  /// @tparam ReverseGraph Template for the reversed graph.
+  /// @tparam EdgeType     Inferred.
+  ///
+  /// Return the bidirectional shortest distance using temporary workspaces.
+  template <
+    typename Graph,
+    typename ReverseGraph,
+    typename EdgeType = typename Graph::EdgeType
+  >
+  static EdgeType
+  BidirectionalQuery(
+      const Graph& graph,
+      const ReverseGraph& reverse,
+      const typename Graph::NodeType& source,
+      const typename Graph::NodeType& target
+  ) requires IndexedGraphConcept<Graph>
+          && IndexedGraphConcept<ReverseGraph> {
+    Workspace<Graph> forward(graph);
+    Workspace<Graph> backward(graph);
+    return BidirectionalQuery(graph, reverse, source, target, forward, backward);
+  }
 };
+
+///
+/// @class Djikstra
+///
+/// The classic shortest path algorithm.  Graphs with unsigned integer weights
+/// are solved with a radix heap, all others with a 4-ary indexed heap.
+///
+using Djikstra = BasicDjikstra<>;
 } // ns search
 #endif // SEARCH_ALGORITHM_DJIKSTRA_HH_
@@ -1,10 +1,17 @@
 #ifndef SEARCH_ALGORITHM_FLOYD_WARSHALL_HH_
 #define SEARCH_ALGORITHM_FLOYD_WARSHALL_HH_
 
+#include <algorithm>
+#include <barrier>
 #include <cassert>
+#include <utility>
 
+#include "search/graph/common.hh"
 #include "search/graph/neighbor_graph.hh"
 #include "search/matrix/dense.hh"
+#include "search/matrix/fixed_point.hh"
+#include "search/matrix/tropical.hh"
+#include "search/parallel/common.hh"
 
 namespace search {
 ///
@@ -13,64 +20,250 @@ namespace search {
 /// The Floyd Warshall algorithm is used to solve all shortest paths amongst
 /// all nodes in a graph.
 ///
+/// Row major `DenseMatrix` storage is solved in square tiles (Venkataraman
+/// et al.).  For each diagonal tile the pivots it spans are first applied
+/// to the tile itself, then to the tiles sharing its row and column, then
+/// to every other tile.  Each step only reads tiles which are already final
+/// for those pivots, so a tile is brought into cache once per step instead
+/// of the whole matrix once per pivot.  Without predecessors, the tiles are
+/// updated a row at a time by the vectorized `MinPlus::Row`.  The tiles of
+/// a step are independent, so they are shared out between threads.  Any
+/// other matrix type runs the textbook loop on one thread.
+///
+/// The matrix may hold unsigned fixed point instead of the graph's edge
+/// type, such as `DenseMatrix<uint16_t>`, see `FixedPoint`.  Edges are
+/// rounded once and sums saturate into the sentinal.
+///
 class FloydWarshall {
  public:
+  ///
+  /// @struct Spec
+  ///
+  /// Specification for the Floyd Warshall solver.
+  ///
+  struct Spec {
+    /// Side of a square tile, in elements.  The three tiles of a step
+    /// should fit in L1 or L2, 64 is 16 KiB per tile of `float`.  0
+    /// disables tiling.
+    std::size_t block   = 64;
+    /// Number of threads for dense storage, 0 means "all of them".
+    std::size_t threads = 1;
+    /// Fixed point scale for unsigned storage, see `StoreDistance`.
+    double      scale   = 1.0;
+  };
+
+  /// @tparam record     Set to `Record::PREDECESSORS` to also store the
+  ///                    predecessor of every pair.
   /// @tparam Graph      Template for the graph.
   /// @tparam MatrixType This only needs to be overriden if you want sparse.
   /// @tparam NodeType   Inferred.
   /// @tparam EdgeType   Inferred.
   template <
+    Record   record     = Record::DISTANCES,
     typename Graph,
     typename MatrixType = DenseMatrix<typename Graph::EdgeType>,
     typename NodeType = typename Graph::NodeType,
     typename EdgeType = typename Graph::EdgeType
   >
-  static NeighborGraphSolution<NodeType, MatrixType>
-  Solve(const Graph& graph) {
-    assert(matrix.Rows() == matrix.Cols());
-
-    auto node_map = graph.BuildNodeMap();
-    MatrixType matrix(
-        graph.NodeCount(),
-        graph.NodeCount(),
-        graph.DefaultValue()
+  static NeighborGraphSolution<NodeType, MatrixType, record>
+  Solve(const Graph& graph, Spec spec = {})
+    requires IndexedGraphConcept<Graph> {
+    using IndexType = typename Graph::IndexType;
+    using StoreType = typename MatrixType::Type;
+
+    NeighborGraphSolution<NodeType, MatrixType, record> solution(
+        graph.BuildNodeMap(),
+        true,
+        StoreDistance<StoreType>(graph.DefaultValue(), spec.scale)
     );
+    MatrixType& matrix = solution.Edges();
+
+    for (IndexType idx_fr = 0; idx_fr < graph.NodeCount(); ++idx_fr) {
+      for (const auto& neigh: graph.IndexNeighbors(idx_fr)) {
+        // Keep the cheapest of parallel edges.
+        const StoreType value = StoreDistance<StoreType>(neigh.edge, spec.scale);
+        const StoreType edge  = matrix.Get(idx_fr, neigh.index);
+        if (edge != matrix.DefaultValue() && !(value < edge))
+          continue;
 
-    for (const auto& node: graph.Nodes()) {
-      std::size_t idx_fr = node_map[node];
-      for (const auto& neigh: graph.Neighbors(node)) {
-        std::size_t idx_to = node_map[neigh.node];
-        matrix.At(idx_fr, idx_to) = neigh.edge;
+        matrix.Set(idx_fr, neigh.index, value);
+        if constexpr (record == Record::PREDECESSORS)
+          solution.Predecessors().At(idx_fr, neigh.index) = idx_fr;
       }
     }
 
+    for (std::size_t idx = 0; idx < matrix.Rows(); ++idx)
+      if (matrix.Get(idx, idx) == matrix.DefaultValue()
+       || StoreType(0) < matrix.Get(idx, idx))
+        matrix.Set(idx, idx, StoreType(0));
+
+    if constexpr (requires { matrix.Row(0); }) {
+      const std::size_t threads = std::min(ThreadCount(spec.threads),
+                                           std::max<std::size_t>(1, matrix.Rows()));
+      if (spec.block)
+        ImplBlocked(solution, spec.block, threads);
+      else
+        ImplRows(solution, threads);
+    } else {
+      ImplLoop(solution);
+    }
+
+    return solution;
+  }
+
+ private:
+  ///
+  /// Textbook triple loop, for matrices without contiguous rows.
+  ///
+  template <typename Solution>
+  static void
+  ImplLoop(Solution& solution) {
+    auto& matrix = solution.Edges();
+
     for (std::size_t k = 0; k < matrix.Rows(); ++k) {
-      bool changed = false;
       for (std::size_t i = 0; i < matrix.Rows(); ++i) {
+        const auto c = matrix.Get(i, k);
+        if (c == matrix.DefaultValue())
+          continue;
+
         for (std::size_t j = 0; j < matrix.Cols(); ++j) {
           const auto a = matrix.Get(i, j);
           const auto b = matrix.Get(k, j);
-          const auto c = matrix.Get(i, k);
 
-          if (b == matrix.DefaultValue()
-           || c == matrix.DefaultValue())
+          if (b == matrix.DefaultValue())
             continue;
 
-          if (b + c < a) {
-            matrix.Set(i, j, b + c);
-            changed = true;
+          const auto sum = MinPlus::Add(b, c);
+          if (a == matrix.DefaultValue() || sum < a) {
+            matrix.Set(i, j, sum);
+            if constexpr (Solution::kPredecessors)
+              solution.Predecessors().At(i, j) = solution.Predecessors().At(k, j);
           }
         }
       }
-
-      if (!changed)
-        break;
     }
+  }
 
-    return NeighborGraphSolution<NodeType, MatrixType>(
-        std::move(node_map),
-        std::move(matrix)
-    );
+  ///
+  /// Untiled loop over raw rows.  For each pivot the rows are split into
+  /// one contiguous chunk per thread, with a barrier between pivots.  The
+  /// pivot row itself can not improve through its own pivot, so it is
+  /// skipped and other threads may read it freely.
+  ///
+  template <typename Solution>
+  static void
+  ImplRows(Solution& solution, std::size_t threads) {
+    const std::size_t count = solution.Edges().Rows();
+    std::barrier sync(threads);
+
+    ParallelRun(threads, [&](std::size_t thread) {
+      const std::size_t lo = count * thread / threads;
+      const std::size_t hi = count * (thread + 1) / threads;
+
+      for (std::size_t k = 0; k < count; ++k) {
+        ImplTile(solution, lo, std::min(hi, k), 0, count, k, k + 1);
+        ImplTile(solution, std::max(lo, k + 1), hi, 0, count, k, k + 1);
+        sync.arrive_and_wait();
+      }
+    });
+  }
+
+  ///
+  /// Run every phase of the tiled algorithm with tiles of `block`.  The
+  /// tiles of a phase are independent and dealt out round robin to
+  /// `threads` threads, with a barrier between phases.
+  ///
+  template <typename Solution>
+  static void
+  ImplBlocked(Solution& solution, std::size_t block, std::size_t threads) {
+    const std::size_t count  = solution.Edges().Rows();
+    const std::size_t blocks = (count + block - 1) / block;
+    const std::size_t others = blocks - 1;
+
+    auto range = [&](std::size_t tile) {
+      return std::pair{tile * block, std::min(count, (tile + 1) * block)};
+    };
+
+    // Number a tile among those which skip `kb`.
+    auto skip = [](std::size_t tile, std::size_t kb) {
+      return tile < kb ? tile : tile + 1;
+    };
+
+    std::barrier sync(threads);
+
+    ParallelRun(threads, [&](std::size_t thread) {
+      for (std::size_t kb = 0; kb < blocks; ++kb) {
+        const auto [k0, k1] = range(kb);
+
+        // Diagonal tile.
+        if (thread == 0)
+          ImplTile(solution, k0, k1, k0, k1, k0, k1);
+        sync.arrive_and_wait();
+
+        // Row and column panels.
+        for (std::size_t task = thread; task < 2 * others; task += threads) {
+          const auto [t0, t1] = range(skip(task / 2, kb));
+          if (task % 2 == 0)
+            ImplTile(solution, k0, k1, t0, t1, k0, k1);
+          else
+            ImplTile(solution, t0, t1, k0, k1, k0, k1);
+        }
+        sync.arrive_and_wait();
+
+        // Everything else.
+        for (std::size_t task = thread; task < others * others; task += threads) {
+          const auto [i0, i1] = range(skip(task / others, kb));
+          const auto [j0, j1] = range(skip(task % others, kb));
+          ImplTile(solution, i0, i1, j0, j1, k0, k1);
+        }
+        sync.arrive_and_wait();
+      }
+    });
+  }
+
+  ///
+  /// Relax rows `[i0, i1)` and cols `[j0, j1)` through pivots `[k0, k1)`,
+  /// working on the raw rows of the matrix.
+  ///
+  template <typename Solution>
+  static void
+  ImplTile(
+      Solution& solution,
+      std::size_t i0, std::size_t i1,
+      std::size_t j0, std::size_t j1,
+      std::size_t k0, std::size_t k1
+  ) {
+    using EdgeType = typename Solution::EdgeType;
+
+    auto& matrix = solution.Edges();
+    const EdgeType sentinal = matrix.DefaultValue();
+
+    for (std::size_t k = k0; k < k1; ++k) {
+      const EdgeType* row_k = matrix.Row(k);
+
+      for (std::size_t i = i0; i < i1; ++i) {
+        EdgeType* row_i = matrix.Row(i);
+        const EdgeType c = row_i[k];
+        if (c == sentinal)
+          continue;
+
+        if constexpr (!Solution::kPredecessors) {
+          MinPlus::Row(row_i + j0, row_k + j0, c, sentinal, j1 - j0);
+        } else {
+          for (std::size_t j = j0; j < j1; ++j) {
+            const EdgeType b = row_k[j];
+            if (b == sentinal)
+              continue;
+
+            const EdgeType sum = MinPlus::Add(b, c);
+            if (row_i[j] == sentinal || sum < row_i[j]) {
+              row_i[j] = sum;
+              solution.Predecessors().At(i, j) = solution.Predecessors().At(k, j);
+            }
+          }
+        }
+      }
+    }
   }
 };
 } // ns search
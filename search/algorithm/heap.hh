@@ -0,0 +1,545 @@
+#ifndef SEARCH_ALGORITHM_HEAP_HH_
+#define SEARCH_ALGORITHM_HEAP_HH_
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <concepts>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace search {
+///
+/// @class HeapError
+///
+/// Thrown when a key is pushed outside the range a bounded queue covers.
+///
+class HeapError : public std::runtime_error {
+ public:
+  explicit HeapError(const std::string& what)
+    : std::runtime_error("HeapError: " + what) {}
+};
+
+///
+/// @struct HeapEntry
+/// @tparam KeyType    Priority of the entry, smallest first.
+/// @tparam IndexType  Dense node index.
+///
+template <typename KeyType, typename IndexType>
+struct HeapEntry {
+  KeyType   key;
+  IndexType index;
+
+  bool
+  operator>(const HeapEntry& other) const {
+    return key > other.key;
+  }
+};
+
+///
+/// This is a C++ concept for the priority queues which can be plugged into
+/// the shortest path solvers.  `Push` either inserts an index or lowers its
+/// key; a heap is allowed to keep stale duplicates, so consumers must skip
+/// indices they have already settled.
+///
+template <typename Heap>
+concept HeapConcept =
+  requires(Heap heap, typename Heap::KeyType key, typename Heap::IndexType index) {
+  { heap.Empty()           } -> std::convertible_to<bool>;
+  { heap.Size()            } -> std::convertible_to<std::size_t>;
+  { heap.Push(index, key)  };
+  { heap.Pop().index       } -> std::convertible_to<typename Heap::IndexType>;
+  { heap.Clear()           };
+};
+
+///
+/// @class  DaryHeap
+/// @tparam KeyType_    Priority of an entry, smallest first.
+/// @tparam IndexType_  Dense node index.
+/// @tparam arity       Number of children per heap node.
+///
+/// An indexed d-ary min heap over dense indices `[0, capacity)`.  Each index
+/// is stored at most once and `Push` on a stored index performs a
+/// decrease-key, so the heap never grows past `capacity` entries.
+///
+template <
+  typename KeyType_,
+  typename IndexType_ = std::uint32_t,
+  std::size_t arity   = 4
+>
+class DaryHeap {
+  static_assert(arity >= 2, "DaryHeap requires an arity of at least 2");
+
+ public:
+  using KeyType   = KeyType_;
+  using IndexType = IndexType_;
+  using Entry     = HeapEntry<KeyType, IndexType>;
+
+  ///
+  /// @param capacity  One past the largest index which will be pushed.
+  ///
+  explicit DaryHeap(std::size_t capacity = 0)
+    : position(capacity, kAbsent)
+  {
+    heap.reserve(capacity);
+  }
+
+  ///
+  /// Return true if there are no entries.
+  ///
+  bool
+  Empty() const {
+    return heap.empty();
+  }
+
+  ///
+  /// Return the number of entries.
+  ///
+  std::size_t
+  Size() const {
+    return heap.size();
+  }
+
+  ///
+  /// @param index Index to look for.
+  ///
+  /// Return true if `index` is currently stored in the heap.
+  ///
+  bool
+  Contains(IndexType index) const {
+    return index < position.size() && position[index] != kAbsent;
+  }
+
+  ///
+  /// @param index Index to insert.
+  /// @param key   Priority for the index.
+  ///
+  /// Insert `index`, or lower its key if it is already stored.  A key which
+  /// is not lower than the stored key is ignored.
+  ///
+  void
+  Push(IndexType index, KeyType key) {
+    if (index >= position.size())
+      position.resize(index + 1, kAbsent);
+
+    std::size_t slot = position[index];
+    if (slot == kAbsent) {
+      slot = heap.size();
+      heap.push_back({key, index});
+    } else if (key < heap[slot].key) {
+      heap[slot].key = key;
+    } else {
+      return;
+    }
+
+    SiftUp(slot);
+  }
+
+  ///
+  /// Return the entry with the smallest key without removing it.
+  ///
+  const Entry&
+  Top() const {
+    assert(!heap.empty());
+    return heap.front();
+  }
+
+  ///
+  /// Remove and return the entry with the smallest key.
+  ///
+  Entry
+  Pop() {
+    assert(!heap.empty());
+    const Entry top = heap.front();
+    position[top.index] = kAbsent;
+
+    const Entry last = heap.back();
+    heap.pop_back();
+
+    if (!heap.empty()) {
+      heap.front() = last;
+      position[last.index] = 0;
+      SiftDown(0);
+    }
+
+    return top;
+  }
+
+  ///
+  /// Remove every entry.  This costs O(size), not O(capacity).
+  ///
+  void
+  Clear() {
+    for (const auto& entry: heap)
+      position[entry.index] = kAbsent;
+    heap.clear();
+  }
+
+ private:
+  static constexpr IndexType kAbsent = std::numeric_limits<IndexType>::max();
+
+  std::vector<Entry>     heap;
+  std::vector<IndexType> position;
+
+  void
+  SiftUp(std::size_t slot) {
+    const Entry entry = heap[slot];
+
+    while (slot > 0) {
+      const std::size_t parent = (slot - 1) / arity;
+      if (!(entry.key < heap[parent].key))
+        break;
+
+      heap[slot] = heap[parent];
+      position[heap[slot].index] = slot;
+      slot = parent;
+    }
+
+    heap[slot] = entry;
+    position[entry.index] = slot;
+  }
+
+  void
+  SiftDown(std::size_t slot) {
+    const Entry entry = heap[slot];
+    const std::size_t size = heap.size();
+
+    while (true) {
+      const std::size_t first = slot * arity + 1;
+      if (first >= size)
+        break;
+
+      const std::size_t last = std::min(first + arity, size);
+      std::size_t best = first;
+      for (std::size_t child = first + 1; child < last; ++child)
+        if (heap[child].key < heap[best].key)
+          best = child;
+
+      if (!(heap[best].key < entry.key))
+        break;
+
+      heap[slot] = heap[best];
+      position[heap[slot].index] = slot;
+      slot = best;
+    }
+
+    heap[slot] = entry;
+    position[entry.index] = slot;
+  }
+};
+
+///
+/// @class  LazyHeap
+/// @tparam KeyType_    Priority of an entry, smallest first.
+/// @tparam IndexType_  Dense node index.
+///
+/// A `std::priority_queue` which never decreases keys and instead stores
+/// duplicates.  This is the classic textbook queue, kept as a baseline to
+/// benchmark the indexed heaps against.
+///
+template <typename KeyType_, typename IndexType_ = std::uint32_t>
+class LazyHeap {
+ public:
+  using KeyType   = KeyType_;
+  using IndexType = IndexType_;
+  using Entry     = HeapEntry<KeyType, IndexType>;
+
+  explicit LazyHeap(std::size_t = 0) {}
+
+  bool
+  Empty() const {
+    return queue.empty();
+  }
+
+  std::size_t
+  Size() const {
+    return queue.size();
+  }
+
+  void
+  Push(IndexType index, KeyType key) {
+    queue.push({key, index});
+  }
+
+  const Entry&
+  Top() const {
+    return queue.top();
+  }
+
+  Entry
+  Pop() {
+    const Entry top = queue.top();
+    queue.pop();
+    return top;
+  }
+
+  void
+  Clear() {
+    queue = {};
+  }
+
+ private:
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+};
+
+///
+/// @class  RadixHeap
+/// @tparam KeyType_    Priority of an entry, must be an unsigned integer.
+/// @tparam IndexType_  Dense node index.
+///
+/// A monotone radix heap.  Keys pushed must never be smaller than the last
+/// key popped, which always holds for a shortest path search with
+/// non-negative integer weights.  Entries are kept in one bucket per bit of
+/// the key, and are only ever moved to lower buckets, so each entry is moved
+/// at most `digits` times.  Duplicates are kept instead of decreasing keys.
+///
+template <typename KeyType_, typename IndexType_ = std::uint32_t>
+class RadixHeap {
+  static_assert(std::is_unsigned_v<KeyType_>,
+                "RadixHeap requires an unsigned integer key");
+
+ public:
+  using KeyType   = KeyType_;
+  using IndexType = IndexType_;
+  using Entry     = HeapEntry<KeyType, IndexType>;
+
+  explicit RadixHeap(std::size_t = 0) {}
+
+  bool
+  Empty() const {
+    return size == 0;
+  }
+
+  std::size_t
+  Size() const {
+    return size;
+  }
+
+  ///
+  /// @param index Index to insert.
+  /// @param key   Priority, at least the last popped key.
+  ///
+  void
+  Push(IndexType index, KeyType key) {
+    assert(key >= last);
+    buckets[Bucket(key)].push_back({key, index});
+    ++size;
+  }
+
+  ///
+  /// Remove and return an entry with the smallest key.
+  ///
+  Entry
+  Pop() {
+    assert(size > 0);
+
+    if (buckets[0].empty()) {
+      std::size_t bucket = 1;
+      while (buckets[bucket].empty())
+        ++bucket;
+
+      // Every entry in the first non-empty bucket lands in a lower bucket
+      // once `last` moves up to the smallest of them.
+      auto& source = buckets[bucket];
+      last = std::min_element(
+          source.begin(), source.end(),
+          [](const Entry& a, const Entry& b) { return a.key < b.key; }
+      )->key;
+
+      for (const auto& entry: source)
+        buckets[Bucket(entry.key)].push_back(entry);
+      source.clear();
+    }
+
+    const Entry top = buckets[0].back();
+    buckets[0].pop_back();
+    --size;
+
+    return top;
+  }
+
+  void
+  Clear() {
+    for (auto& bucket: buckets)
+      bucket.clear();
+    last = 0;
+    size = 0;
+  }
+
+ private:
+  static constexpr std::size_t kBuckets = std::numeric_limits<KeyType>::digits + 1;
+
+  std::array<std::vector<Entry>, kBuckets> buckets;
+  KeyType     last = 0;
+  std::size_t size = 0;
+
+  std::size_t
+  Bucket(KeyType key) const {
+    return std::bit_width(static_cast<KeyType>(key ^ last));
+  }
+};
+
+///
+/// @class  BucketQueue
+/// @tparam KeyType_    Priority of an entry, must be an unsigned integer.
+/// @tparam IndexType_  Dense node index.
+/// @tparam max_weight  Largest edge weight in the graph.
+///
+/// Dial's bucket queue: a circular array of `max_weight + 1` buckets, one per
+/// key.  Every stored key lies within `max_weight` of the last popped key,
+/// so each bucket holds a single key and both operations are O(1) amortized.
+/// Only worth it when `max_weight` is small.
+///
+template <
+  typename KeyType_,
+  typename IndexType_ = std::uint32_t,
+  std::size_t max_weight = 255
+>
+class BucketQueue {
+  static_assert(std::is_unsigned_v<KeyType_>,
+                "BucketQueue requires an unsigned integer key");
+
+ public:
+  using KeyType   = KeyType_;
+  using IndexType = IndexType_;
+  using Entry     = HeapEntry<KeyType, IndexType>;
+
+  explicit BucketQueue(std::size_t = 0)
+    : buckets(max_weight + 1)
+  {}
+
+  bool
+  Empty() const {
+    return size == 0;
+  }
+
+  std::size_t
+  Size() const {
+    return size;
+  }
+
+  ///
+  /// @param index Index to insert.
+  /// @param key   Priority, within `max_weight` of the last popped key.
+  ///
+  /// Throws `HeapError` for any other key, which would wrap into an earlier
+  /// bucket and be popped out of order, such as one reached by an edge
+  /// heavier than `max_weight`.
+  ///
+  void
+  Push(IndexType index, KeyType key) {
+    if (key < cursor || key - cursor > max_weight)
+      throw HeapError("key " + std::to_string(key) + " beyond max_weight "
+                    + std::to_string(max_weight));
+    buckets[key % (max_weight + 1)].push_back({key, index});
+    ++size;
+  }
+
+  ///
+  /// Remove and return an entry with the smallest key.
+  ///
+  Entry
+  Pop() {
+    assert(size > 0);
+
+    while (buckets[cursor % (max_weight + 1)].empty())
+      ++cursor;
+
+    auto& bucket = buckets[cursor % (max_weight + 1)];
+    const Entry top = bucket.back();
+    bucket.pop_back();
+    --size;
+
+    return top;
+  }
+
+  void
+  Clear() {
+    for (auto& bucket: buckets)
+      bucket.clear();
+    cursor = 0;
+    size = 0;
+  }
+
+ private:
+  std::vector<std::vector<Entry>> buckets;
+  KeyType     cursor = 0;
+  std::size_t size = 0;
+};
+
+///
+/// @struct DaryHeapPolicy
+/// @tparam arity  Number of children per heap node.
+///
+/// Heap policy selecting an indexed `DaryHeap`.  A heap policy is any type
+/// with a nested `Heap<KeyType, IndexType>` template satisfying
+/// `HeapConcept`.
+///
+template <std::size_t arity = 4>
+struct DaryHeapPolicy {
+  template <typename KeyType, typename IndexType>
+  using Heap = DaryHeap<KeyType, IndexType, arity>;
+};
+
+///
+/// @struct LazyHeapPolicy
+///
+/// Heap policy selecting the lazy `std::priority_queue` baseline.
+///
+struct LazyHeapPolicy {
+  template <typename KeyType, typename IndexType>
+  using Heap = LazyHeap<KeyType, IndexType>;
+};
+
+///
+/// @struct RadixHeapPolicy
+///
+/// Heap policy selecting a `RadixHeap`, for unsigned integer weights.
+///
+struct RadixHeapPolicy {
+  template <typename KeyType, typename IndexType>
+  using Heap = RadixHeap<KeyType, IndexType>;
+};
+
+///
+/// @struct BucketHeapPolicy
+/// @tparam max_weight  Largest edge weight in the graph.
+///
+/// Heap policy selecting Dial's `BucketQueue`, for small unsigned integer
+/// weights bounded by `max_weight`.
+///
+template <std::size_t max_weight>
+struct BucketHeapPolicy {
+  template <typename KeyType, typename IndexType>
+  using Heap = BucketQueue<KeyType, IndexType, max_weight>;
+};
+
+///
+/// @struct DefaultHeapPolicy
+///
+/// Heap policy picking the queue from the key type: a `RadixHeap` for
+/// unsigned integer keys, and a 4-ary `DaryHeap` for everything else.
+///
+struct DefaultHeapPolicy {
+  template <typename KeyType>
+  static constexpr bool kRadix = std::is_integral_v<KeyType>
+                              && std::is_unsigned_v<KeyType>
+                              && !std::is_same_v<KeyType, bool>;
+
+  template <typename KeyType, typename IndexType>
+  using Heap = std::conditional_t<
+      kRadix<KeyType>,
+      RadixHeap<KeyType, IndexType>,
+      DaryHeap<KeyType, IndexType, 4>
+  >;
+};
+} // ns search
+
+#endif // SEARCH_ALGORITHM_HEAP_HH_
@@ -0,0 +1,188 @@
+#ifndef SEARCH_ALGORITHM_INCREMENTAL_UPDATE_HH_
+#define SEARCH_ALGORITHM_INCREMENTAL_UPDATE_HH_
+
+#include <cassert>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "search/graph/neighbor_graph.hh"
+#include "search/matrix/tropical.hh"
+
+namespace search {
+///
+/// @class NegativeCycleError
+///
+/// Thrown when an update to an all pairs solution would close a cycle of
+/// negative weight, after which no shortest path is defined.
+///
+class NegativeCycleError : public std::runtime_error {
+ public:
+  explicit NegativeCycleError(const std::string& what)
+    : std::runtime_error("NegativeCycleError: " + what) {}
+};
+
+///
+/// @struct EdgeUpdate
+/// @tparam NodeType  Type of the nodes.
+/// @tparam EdgeType  Type of the weight.
+///
+/// An edge inserted into the solved graph, or the new lower weight of an
+/// existing one, see `IncrementalUpdate::DecreaseEdges`.
+///
+template <typename NodeType, typename EdgeType>
+struct EdgeUpdate {
+  NodeType fr;
+  NodeType to;
+  EdgeType edge;
+};
+
+///
+/// @class IncrementalUpdate
+///
+/// Keeps an all pairs `NeighborGraphSolution` current while edges are added
+/// to the solved graph or get cheaper.  A pair can only improve by a path
+/// through the changed edge, so every `(i, j)` becomes
+/// `min(d(i, j), d(i, fr) + edge + d(to, j))`, which is `O(N^2)` per edge
+/// instead of solving again.  Rows which do not even reach `to` sooner are
+/// skipped.
+///
+class IncrementalUpdate {
+ public:
+  ///
+  /// @tparam Solution Inferred.
+  /// @param  solution All pairs solution to update.
+  /// @param  fr       Edge 'from'.
+  /// @param  to       Edge 'to'.
+  /// @param  edge     Weight of the inserted edge, or new weight of the edge.
+  ///
+  /// Update the distances, and predecessors if recorded, for an edge
+  /// `fr -> to` which was added to the graph or whose weight went down to
+  /// `edge`.  Both nodes must already be in the solution, and an undirected
+  /// edge needs both directions.
+  ///
+  /// Returns true if any distance changed.  Throws `NegativeCycleError`,
+  /// leaving the solution untouched, if the edge closes a negative cycle.
+  ///
+  template <typename Solution>
+  static bool
+  DecreaseEdge(
+      Solution& solution,
+      const typename Solution::NodeType& fr,
+      const typename Solution::NodeType& to,
+      typename Solution::EdgeType edge
+  ) {
+    assert(solution.Edges().Rows() == solution.Edges().Cols());
+    const auto& nodes = solution.Nodes();
+    return ImplDecrease(solution, nodes.at(fr), nodes.at(to), edge);
+  }
+
+  ///
+  /// @tparam Solution Inferred.
+  /// @param  solution All pairs solution to update.
+  /// @param  updates  Edges to apply, in order.
+  ///
+  /// Apply `DecreaseEdge` to every update, `O(K N^2)` for `K` updates.
+  /// Every node is looked up before anything changes.  Returns true if any
+  /// distance changed.
+  ///
+  template <typename Solution>
+  static bool
+  DecreaseEdges(
+      Solution& solution,
+      std::span<const EdgeUpdate<
+          typename Solution::NodeType,
+          typename Solution::EdgeType
+      >> updates
+  ) {
+    using IndexType = typename Solution::IndexType;
+    assert(solution.Edges().Rows() == solution.Edges().Cols());
+
+    const auto& nodes = solution.Nodes();
+    std::vector<std::pair<IndexType, IndexType>> indices;
+    indices.reserve(updates.size());
+    for (const auto& update: updates)
+      indices.emplace_back(nodes.at(update.fr), nodes.at(update.to));
+
+    bool changed = false;
+    for (std::size_t n = 0; n < updates.size(); ++n)
+      changed |= ImplDecrease(solution, indices[n].first, indices[n].second,
+                              updates[n].edge);
+
+    return changed;
+  }
+
+ private:
+  ///
+  /// Relax every pair through a new edge `fr -> to` of weight `edge`.  Row
+  /// `to` and column `fr` can not improve without a negative cycle, so they
+  /// are read while other rows are updated in place.  Relies on the zero
+  /// diagonal every all pairs solver stores.
+  ///
+  template <typename Solution>
+  static bool
+  ImplDecrease(
+      Solution& solution,
+      typename Solution::IndexType fr,
+      typename Solution::IndexType to,
+      typename Solution::EdgeType edge
+  ) {
+    using MatrixType = typename Solution::MatrixType;
+    using EdgeType   = typename Solution::EdgeType;
+
+    MatrixType& edges = solution.Edges();
+    const EdgeType    none  = edges.DefaultValue();
+    const std::size_t count = edges.Rows();
+
+    const EdgeType back = edges.Get(to, fr);
+    if (back != none && MinPlus::Add(back, edge) < EdgeType(0))
+      throw NegativeCycleError("edge closes a negative cycle");
+
+    const EdgeType current = edges.Get(fr, to);
+    if (current != none && !(edge < current))
+      return false;
+
+    for (std::size_t i = 0; i < count; ++i) {
+      const EdgeType head = edges.Get(i, fr);
+      if (head == none)
+        continue;
+
+      // By the triangle inequality a row which does not reach `to` sooner
+      // can not reach anything beyond it sooner either.
+      const EdgeType via = MinPlus::Add(head, edge);
+      const EdgeType old = edges.Get(i, to);
+      if (old != none && !(via < old))
+        continue;
+
+      if constexpr (!Solution::kPredecessors
+                 && requires (MatrixType& m) { m.Row(0); }) {
+        MinPlus::Row(edges.Row(i), edges.Row(to), via, none, count);
+      } else {
+        for (std::size_t j = 0; j < count; ++j) {
+          const EdgeType tail = edges.Get(to, j);
+          if (tail == none)
+            continue;
+
+          const EdgeType dist = MinPlus::Add(via, tail);
+          const EdgeType prev = edges.Get(i, j);
+          if (prev != none && !(dist < prev))
+            continue;
+
+          edges.Set(i, j, dist);
+          if constexpr (Solution::kPredecessors) {
+            auto& predecessors = solution.Predecessors();
+            predecessors.At(i, j) = (j == to) ? fr : predecessors.At(to, j);
+          }
+        }
+      }
+    }
+
+    return true;
+  }
+};
+} // ns search
+
+#endif // SEARCH_ALGORITHM_INCREMENTAL_UPDATE_HH_
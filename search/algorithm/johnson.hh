@@ -0,0 +1,157 @@
+#ifndef SEARCH_ALGORITHM_JOHNSON_HH_
+#define SEARCH_ALGORITHM_JOHNSON_HH_
+
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+#include "search/algorithm/bellman_ford.hh"
+#include "search/algorithm/djikstra.hh"
+#include "search/graph/common.hh"
+#include "search/graph/neighbor_graph.hh"
+#include "search/matrix/dense.hh"
+
+namespace search {
+///
+/// @class Johnson
+///
+/// All pairs shortest path for sparse graphs with negative edges.
+///
+/// `BellmanFord::Potentials` finds a potential `h` per node, every edge is
+/// reweighted to `edge + h(fr) - h(to)`, which is never negative, and
+/// `Djikstra` runs from every node.  A reweighted distance is turned back
+/// with `- h(fr) + h(to)`.  Shortest paths are the same under both weights,
+/// so recorded predecessors need no adjustment.
+///
+/// This is `O(N E log N)` instead of the `O(N^3)` of `FloydWarshall`.
+///
+class Johnson {
+ public:
+  ///
+  /// @struct Spec
+  ///
+  /// Specification for the Johnson solver.
+  ///
+  struct Spec {
+    /// Number of threads running `Djikstra`, 0 means "all of them".
+    std::size_t threads = 1;
+  };
+
+  /// @tparam record     Set to `Record::PREDECESSORS` to also store every
+  ///                    shortest path tree.
+  /// @tparam Graph      Template for the graph.
+  /// @tparam MatrixType This only needs to be overriden if you want sparse.
+  /// @tparam NodeType   Inferred.
+  /// @tparam EdgeType   Inferred.
+  ///
+  /// Solve the shortest path for all starting nodes.  Throws
+  /// `BellmanFordNegativeWeight` if the graph has a negative cycle.
+  template <
+    Record   record     = Record::DISTANCES,
+    typename Graph,
+    typename MatrixType = DenseMatrix<typename Graph::EdgeType>,
+    typename NodeType   = typename Graph::NodeType,
+    typename EdgeType   = typename Graph::EdgeType
+  >
+  static NeighborGraphSolution<NodeType, MatrixType, record>
+  Solve(const Graph& graph, Spec spec = {})
+    requires IndexedGraphConcept<Graph> {
+    const std::vector<EdgeType> potentials = BellmanFord::Potentials(graph);
+    const Reweighted<Graph> reweighted(graph, potentials);
+
+    auto solution = Djikstra::Solve<record, Reweighted<Graph>, MatrixType>(
+        reweighted,
+        Djikstra::Spec{.threads = spec.threads}
+    );
+
+    MatrixType& matrix = solution.Edges();
+    for (std::size_t fr = 0; fr < graph.NodeCount(); ++fr) {
+      for (std::size_t to = 0; to < graph.NodeCount(); ++to) {
+        const EdgeType dist = matrix.Get(fr, to);
+        if (dist != matrix.DefaultValue())
+          matrix.Set(fr, to, dist - potentials[fr] + potentials[to]);
+      }
+    }
+
+    return solution;
+  }
+
+ private:
+  ///
+  /// @class  Reweighted
+  /// @tparam Graph  Template for the wrapped graph.
+  ///
+  /// A compressed copy of the edges of `Graph` under reweighted costs,
+  /// which forwards every node lookup to the wrapped graph.
+  ///
+  template <typename Graph>
+  class Reweighted {
+   public:
+    using NodeType  = typename Graph::NodeType;
+    using EdgeType  = typename Graph::EdgeType;
+    using IndexType = typename Graph::IndexType;
+    using EdgeList  = IndexEdgeRange<IndexType, EdgeType>;
+
+    Reweighted(const Graph& graph, const std::vector<EdgeType>& potentials)
+      : graph(graph)
+    {
+      offsets.reserve(graph.NodeCount() + 1);
+      offsets.push_back(0);
+
+      for (IndexType idx = 0; idx < graph.NodeCount(); ++idx) {
+        for (const auto& neigh: graph.IndexNeighbors(idx)) {
+          // Rounding may leave a float a hair below zero.
+          const EdgeType edge = neigh.edge + potentials[idx] - potentials[neigh.index];
+          targets.push_back(neigh.index);
+          weights.push_back(std::max(edge, EdgeType(0)));
+        }
+
+        offsets.push_back(targets.size());
+      }
+    }
+
+    std::size_t
+    NodeCount() const {
+      return graph.NodeCount();
+    }
+
+    EdgeType
+    DefaultValue() const {
+      return graph.DefaultValue();
+    }
+
+    IndexType
+    Index(const NodeType& node) const {
+      return graph.Index(node);
+    }
+
+    decltype(auto)
+    Node(IndexType index) const {
+      return graph.Node(index);
+    }
+
+    auto
+    BuildNodeMap() const {
+      return graph.BuildNodeMap();
+    }
+
+    EdgeList
+    IndexNeighbors(IndexType index) const {
+      assert(index < NodeCount());
+      return EdgeList(
+          targets.data() + offsets[index],
+          weights.data() + offsets[index],
+          offsets[index + 1] - offsets[index]
+      );
+    }
+
+   private:
+    const Graph&             graph;
+    std::vector<std::size_t> offsets;
+    std::vector<IndexType>   targets;
+    std::vector<EdgeType>    weights;
+  };
+};
+} // ns search
+
+#endif // SEARCH_ALGORITHM_JOHNSON_HH_
@@ -0,0 +1,361 @@
+#ifndef SEARCH_ALGORITHM_LANDMARKS_HH_
+#define SEARCH_ALGORITHM_LANDMARKS_HH_
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "search/algorithm/astar.hh"
+#include "search/algorithm/common.hh"
+#include "search/algorithm/djikstra.hh"
+#include "search/graph/common.hh"
+#include "search/matrix/dense.hh"
+
+namespace search {
+///
+/// @enum LandmarkSelection
+/// How landmarks are picked.
+///
+enum class LandmarkSelection {
+  /// Each landmark is the node farthest from the landmarks picked so far.
+  FARTHEST = 1,
+  /// Each landmark is a leaf of the shortest path subtree whose nodes have
+  /// the worst current lower bounds from a random root (Goldberg and
+  /// Werneck).
+  AVOID    = 2,
+};
+
+///
+/// @class  Landmarks
+/// @tparam EdgeType_  What data type is being stored in the edge.
+///
+/// ALT (A*, landmarks, triangle inequality) lower bounds.  For a set of
+/// landmarks `L` the distances `d(L, v)` and `d(v, L)` to every node are
+/// precomputed, and the triangle inequality turns them into a lower bound on
+/// `d(v, t)` for any pair, which drives an `AStar` query.
+///
+/// The tables are `K x N` column major matrices, so the `K` distances of one
+/// node are contiguous.
+///
+template <typename EdgeType_>
+class Landmarks {
+ public:
+  using EdgeType  = EdgeType_;
+  using IndexType = std::uint32_t;
+  using Table     = DenseMatrix<EdgeType, Order::COL_MAJOR>;
+
+  ///
+  /// @struct Spec
+  ///
+  /// Specification for picking landmarks.
+  ///
+  struct Spec {
+    /// Number of landmarks, capped at the number of nodes.
+    std::size_t       count     = 16;
+    LandmarkSelection selection = LandmarkSelection::AVOID;
+    /// Seed for the random start and root nodes.
+    std::uint64_t     seed      = 0;
+  };
+
+  ///
+  /// @tparam Graph         Inferred.
+  /// @tparam ReverseGraph  Inferred.
+  /// @param  graph    Graph to pick landmarks on.
+  /// @param  reverse  `graph` with every edge transposed and the same node
+  ///                  indices, see `CompressedNeighborGraph::Reverse`.
+  /// @param  spec     See `Spec`.
+  ///
+  /// Pick landmarks on a directed graph.
+  ///
+  template <typename Graph, typename ReverseGraph>
+  Landmarks(const Graph& graph, const ReverseGraph& reverse, Spec spec = {})
+    requires IndexedGraphConcept<Graph>
+          && IndexedGraphConcept<ReverseGraph>
+    : sentinal(graph.DefaultValue()),
+      count(graph.NodeCount())
+  {
+    assert(graph.NodeCount() == reverse.NodeCount());
+    Select(graph, reverse, spec);
+  }
+
+  ///
+  /// @tparam Graph  Inferred.
+  /// @param  graph  Undirected graph to pick landmarks on.
+  /// @param  spec   See `Spec`.
+  ///
+  /// Pick landmarks on an undirected graph, which is its own reverse.
+  ///
+  template <typename Graph>
+  explicit Landmarks(const Graph& graph, Spec spec = {})
+    requires IndexedGraphConcept<Graph>
+    : Landmarks(graph, graph, spec)
+  {}
+
+  Landmarks(Landmarks&&) = default;
+
+  Landmarks&
+  operator=(Landmarks&&) = default;
+
+  ///
+  /// Return the dense indices of the landmarks, in the order they were
+  /// picked.
+  ///
+  const std::vector<IndexType>&
+  Indices() const {
+    return landmarks;
+  }
+
+  ///
+  /// Return the `K x N` table of distances from each landmark.
+  ///
+  const Table&
+  From() const {
+    return from;
+  }
+
+  ///
+  /// Return the `K x N` table of distances to each landmark.
+  ///
+  const Table&
+  To() const {
+    return to;
+  }
+
+  ///
+  /// @param node_index    Dense index of the node.
+  /// @param target_index  Dense index of the target.
+  ///
+  /// Return a lower bound on the distance from `node_index` to
+  /// `target_index`, the best of the triangle inequalities
+  /// `d(L, t) - d(L, v)` and `d(v, L) - d(t, L)` over every landmark.
+  ///
+  EdgeType
+  LowerBound(IndexType node_index, IndexType target_index) const {
+    const std::size_t k = landmarks.size();
+    EdgeType bound = 0;
+    if (k == 0)
+      return bound;
+
+    const EdgeType* from_node   = from.Col(node_index);
+    const EdgeType* from_target = from.Col(target_index);
+    const EdgeType* to_node     = to.Col(node_index);
+    const EdgeType* to_target   = to.Col(target_index);
+
+    for (std::size_t n = 0; n < k; ++n) {
+      // A landmark which reaches the target but not the node gives no bound.
+      if (from_node[n] != sentinal && from_target[n] != sentinal
+       && from_node[n] < from_target[n])
+        bound = std::max<EdgeType>(bound, from_target[n] - from_node[n]);
+
+      if (to_node[n] != sentinal && to_target[n] != sentinal
+       && to_target[n] < to_node[n])
+        bound = std::max<EdgeType>(bound, to_node[n] - to_target[n]);
+    }
+
+    return bound;
+  }
+
+  ///
+  /// @tparam Graph   Inferred.
+  /// @param  graph   The graph the landmarks were picked on.
+  /// @param  source  Start of the path.
+  /// @param  target  End of the path.
+  ///
+  /// Return the shortest path from `source` to `target` using A* with the
+  /// landmark lower bounds.  Each call allocates a workspace, `O(N)`,
+  /// repeated queries should pass one instead.
+  ///
+  template <typename Graph>
+  ShortestPath<typename Graph::NodeType, EdgeType>
+  Path(
+      const Graph& graph,
+      const typename Graph::NodeType& source,
+      const typename Graph::NodeType& target
+  ) const requires IndexedGraphConcept<Graph> {
+    assert(graph.NodeCount() == count);
+
+    const IndexType target_index = graph.Index(target);
+    return AStar::SolveIndex(
+      graph,
+      graph.Index(source),
+      target_index,
+      [&](IndexType index) { return LowerBound(index, target_index); }
+    );
+  }
+
+  ///
+  /// @tparam Graph      Inferred.
+  /// @param  graph      The graph the landmarks were picked on.
+  /// @param  source     Start of the path.
+  /// @param  target     End of the path.
+  /// @param  workspace  Reusable query state.
+  ///
+  /// Return the shortest path using a reusable workspace.
+  ///
+  template <typename Graph>
+  ShortestPath<typename Graph::NodeType, EdgeType>
+  Path(
+      const Graph& graph,
+      const typename Graph::NodeType& source,
+      const typename Graph::NodeType& target,
+      AStar::Workspace<Graph>& workspace
+  ) const requires IndexedGraphConcept<Graph> {
+    assert(graph.NodeCount() == count);
+
+    const IndexType target_index = graph.Index(target);
+    return AStar::SolveIndex(
+      graph,
+      graph.Index(source),
+      target_index,
+      [&](IndexType index) { return LowerBound(index, target_index); },
+      workspace
+    );
+  }
+
+ private:
+  EdgeType               sentinal;
+  std::size_t            count;
+  std::vector<IndexType> landmarks;
+  Table                  from;
+  Table                  to;
+
+  ///
+  /// Pick every landmark and fill the tables.
+  ///
+  template <typename Graph, typename ReverseGraph>
+  void
+  Select(const Graph& graph, const ReverseGraph& reverse, const Spec& spec) {
+    const std::size_t k = std::min(spec.count, count);
+    from = Table(k, count, sentinal);
+    to   = Table(k, count, sentinal);
+    landmarks.reserve(k);
+
+    std::mt19937_64 rng(spec.seed);
+    std::uniform_int_distribution<std::size_t> random_node(0, count ? count - 1 : 0);
+    std::vector<bool> chosen(count, false);
+
+    Djikstra::Workspace<Graph>        forward(graph);
+    Djikstra::Workspace<ReverseGraph> backward(reverse);
+
+    while (landmarks.size() < k) {
+      IndexType next = count;
+      if (spec.selection == LandmarkSelection::AVOID)
+        next = Avoid(graph, random_node(rng), chosen, forward);
+      if (next == count)
+        next = Farthest(graph, random_node(rng), chosen, forward);
+
+      chosen[next] = true;
+      landmarks.push_back(next);
+
+      const std::size_t row = landmarks.size() - 1;
+      Fill(graph,   next, row, from, forward);
+      Fill(reverse, next, row, to,   backward);
+    }
+  }
+
+  ///
+  /// Store the distances from `landmark` on `graph` in row `row` of `table`.
+  ///
+  template <typename Graph>
+  void
+  Fill(const Graph& graph, IndexType landmark, std::size_t row, Table& table,
+       Djikstra::Workspace<Graph>& workspace) {
+    Djikstra::Solve(graph, graph.Node(landmark), workspace);
+    for (IndexType idx = 0; idx < count; ++idx)
+      table.At(row, idx) = workspace.Distance(idx);
+  }
+
+  ///
+  /// Return the unchosen node whose distance from the nearest landmark is
+  /// largest, preferring nodes no landmark reaches.  With no landmarks yet,
+  /// return the node farthest from `start`.
+  ///
+  template <typename Graph>
+  IndexType
+  Farthest(const Graph& graph, IndexType start, const std::vector<bool>& chosen,
+           Djikstra::Workspace<Graph>& workspace) {
+    std::vector<EdgeType> nearest(count, sentinal);
+    if (landmarks.empty()) {
+      Djikstra::Solve(graph, graph.Node(start), workspace);
+      for (IndexType idx = 0; idx < count; ++idx)
+        nearest[idx] = workspace.Distance(idx);
+    } else {
+      for (std::size_t idx = 0; idx < count; ++idx)
+        for (std::size_t n = 0; n < landmarks.size(); ++n)
+          if (from.At(n, idx) != sentinal)
+            nearest[idx] = std::min(nearest[idx], from.At(n, idx));
+    }
+
+    IndexType best = count;
+    for (IndexType idx = 0; idx < count; ++idx) {
+      if (chosen[idx])
+        continue;
+      if (best == count || nearest[best] < nearest[idx])
+        best = idx;
+    }
+
+    return best;
+  }
+
+  ///
+  /// Grow the shortest path tree from `root`, weigh every node by how far
+  /// its current lower bound from `root` is from its distance, and walk
+  /// down into the heaviest subtree which holds no landmark.  Return the
+  /// node it ends at, or `count` if that is already a landmark.
+  ///
+  template <typename Graph>
+  IndexType
+  Avoid(const Graph& graph, IndexType root, const std::vector<bool>& chosen,
+        Djikstra::Workspace<Graph>& workspace) {
+    Djikstra::Solve(graph, graph.Node(root), workspace);
+
+    std::vector<std::vector<IndexType>> children(count);
+    for (IndexType idx = 0; idx < count; ++idx)
+      if (idx != root && workspace.Reached(idx))
+        children[workspace.Parent(idx)].push_back(idx);
+
+    // Breadth first, so every node is listed after its parent.
+    std::vector<IndexType> order{root};
+    for (std::size_t n = 0; n < order.size(); ++n)
+      for (const IndexType child: children[order[n]])
+        order.push_back(child);
+
+    // Subtree weights, zeroed for subtrees holding a landmark.
+    std::vector<double> size(count, 0);
+    std::vector<bool>   blocked(count, false);
+    for (auto iter = order.rbegin(); iter != order.rend(); ++iter) {
+      const IndexType node_index = *iter;
+      blocked[node_index] = blocked[node_index] || chosen[node_index];
+      size[node_index] += double(workspace.Distance(node_index))
+                        - double(LowerBound(root, node_index));
+      if (blocked[node_index])
+        size[node_index] = 0;
+
+      if (node_index != root) {
+        const IndexType up = workspace.Parent(node_index);
+        blocked[up] = blocked[up] || blocked[node_index];
+        size[up] += size[node_index];
+      }
+    }
+
+    IndexType node_index = root;
+    while (true) {
+      IndexType next = count;
+      for (const IndexType child: children[node_index])
+        if (!blocked[child] && (next == count || size[next] < size[child]))
+          next = child;
+
+      if (next == count)
+        break;
+      node_index = next;
+    }
+
+    return chosen[node_index] ? count : node_index;
+  }
+};
+} // ns search
+
+#endif // SEARCH_ALGORITHM_LANDMARKS_HH_
@@ -0,0 +1,94 @@
+#ifndef SEARCH_ALGORITHM_REPEATED_SQUARING_HH_
+#define SEARCH_ALGORITHM_REPEATED_SQUARING_HH_
+
+#include <cstddef>
+#include <utility>
+
+#include "search/graph/common.hh"
+#include "search/graph/neighbor_graph.hh"
+#include "search/matrix/dense.hh"
+#include "search/matrix/tropical.hh"
+
+namespace search {
+///
+/// @class RepeatedSquaring
+///
+/// All pairs shortest path by squaring the adjacency matrix in the (min, +)
+/// semiring.  With a zero diagonal the `n`th square holds every shortest
+/// path of at most `2^n` edges, so `log2(N)` products suffice.  A square
+/// which changes nothing is final, which stops graphs of small diameter
+/// after a few products.
+///
+/// Each product is `O(N^3)` like a whole `FloydWarshall`, but it is a plain
+/// tiled matrix product with no dependency between pivots, so every row is
+/// independent and it splits between threads without barriers.  Only
+/// distances are computed.  Negative edges are allowed, negative cycles are
+/// not detected.
+///
+class RepeatedSquaring {
+ public:
+  ///
+  /// @struct Spec
+  ///
+  /// Specification for the repeated squaring solver.
+  ///
+  struct Spec {
+    /// Side of a square tile of each product, see `MinPlus::Spec`.
+    std::size_t block   = 256;
+    /// Number of threads, 0 means "all of them".
+    std::size_t threads = 1;
+  };
+
+  /// @tparam Graph    Template for the graph.
+  /// @tparam NodeType Inferred.
+  /// @tparam EdgeType Inferred.
+  template <
+    typename Graph,
+    typename NodeType = typename Graph::NodeType,
+    typename EdgeType = typename Graph::EdgeType
+  >
+  static NeighborGraphSolution<NodeType, DenseMatrix<EdgeType>>
+  Solve(const Graph& graph, Spec spec = {})
+    requires IndexedGraphConcept<Graph> {
+    using IndexType = typename Graph::IndexType;
+
+    NeighborGraphSolution<NodeType, DenseMatrix<EdgeType>> solution(
+        graph.BuildNodeMap(),
+        true,
+        graph.DefaultValue()
+    );
+    DenseMatrix<EdgeType>& matrix = solution.Edges();
+
+    for (IndexType idx_fr = 0; idx_fr < graph.NodeCount(); ++idx_fr) {
+      for (const auto& neigh: graph.IndexNeighbors(idx_fr)) {
+        // Keep the cheapest of parallel edges.
+        const EdgeType edge = matrix.Get(idx_fr, neigh.index);
+        if (edge == matrix.DefaultValue() || neigh.edge < edge)
+          matrix.Set(idx_fr, neigh.index, neigh.edge);
+      }
+    }
+
+    for (std::size_t idx = 0; idx < matrix.Rows(); ++idx)
+      if (matrix.Get(idx, idx) == matrix.DefaultValue()
+       || EdgeType(0) < matrix.Get(idx, idx))
+        matrix.Set(idx, idx, EdgeType(0));
+
+    const MinPlus::Spec product = {.block = spec.block, .threads = spec.threads};
+
+    // Every square starts from a copy of the previous one, so the product
+    // reports whether any path got shorter.
+    for (std::size_t hops = 1; hops + 1 < matrix.Rows(); hops *= 2) {
+      DenseMatrix<EdgeType> square = MinPlus::Copy(matrix);
+      const bool changed = MinPlus::MultiplyInto(matrix, matrix, square, product);
+      matrix = std::move(square);
+
+      if (!changed)
+        break;
+    }
+
+    return solution;
+  }
+};
+} // ns search
+
+#endif // SEARCH_ALGORITHM_REPEATED_SQUARING_HH_
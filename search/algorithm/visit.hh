@@ -1,9 +1,266 @@
 #ifndef SEARCH_ALGORITHM_VISIT_HH_
 #define SEARCH_ALGORITHM_VISIT_HH_
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "search/graph/common.hh"
+#include "search/matrix/dense.hh"
+#include "search/parallel/common.hh"
+
 namespace search {
+///
+/// @class  BasicMultiSourceBfs
+/// @tparam width_  Number of sources searched together, a multiple of 64.
+///
+/// Bit-parallel multi-source breadth first search (MS-BFS, Then et al.).
+/// Edge weights are ignored and every edge counts as one hop.
+///
+/// Up to `width` sources share one traversal: each node carries a `width`
+/// bit word saying which sources have seen it and which are visiting it at
+/// the current level, so a node reached by many sources on the same level
+/// has its neighbors scanned once instead of once per source.  More sources
+/// are processed in batches of `width`.
+///
+template <std::size_t width_ = 64>
+class BasicMultiSourceBfs {
+  static_assert(width_ > 0 && width_ % 64 == 0);
+
+ public:
+  static constexpr std::size_t width = width_;
+
+  ///
+  /// @struct Spec
+  ///
+  /// Specification for a multi-source search.
+  ///
+  struct Spec {
+    /// Number of threads, 0 means "all of them".  Each thread searches its
+    /// own batches of `width` sources.
+    std::size_t threads = 1;
+  };
+
+  ///
+  /// @tparam DistanceType  Unsigned type the hop counts are stored in.
+  ///
+  /// Hop count stored for a node a source does not reach.  Nodes more than
+  /// `kUnreached<DistanceType> - 1` hops away are also reported unreached.
+  ///
+  template <std::unsigned_integral DistanceType>
+  static constexpr DistanceType kUnreached = std::numeric_limits<DistanceType>::max();
+
+  /// @tparam DistanceType Unsigned type the hop counts are stored in.
+  /// @tparam Graph        Template for the graph.
+  ///
+  /// Return a `sources.size() x N` matrix whose row `i` holds the hop count
+  /// from `sources[i]` to every node, or `kUnreached`.
+  template <
+    std::unsigned_integral DistanceType = std::uint16_t,
+    typename Graph
+  >
+  static DenseMatrix<DistanceType>
+  Solve(
+      const Graph& graph,
+      std::span<const typename Graph::NodeType> sources,
+      Spec spec = {}
+  ) requires IndexedGraphConcept<Graph> {
+    using IndexType = typename Graph::IndexType;
+
+    std::vector<IndexType> indices;
+    indices.reserve(sources.size());
+    for (const auto& source: sources)
+      indices.push_back(graph.Index(source));
+
+    return SolveIndex<DistanceType>(graph, indices, spec);
+  }
+
+  /// @tparam DistanceType Unsigned type the hop counts are stored in.
+  /// @tparam Graph        Template for the graph.
+  ///
+  /// Index level entry point, `sources` are dense node indices.
+  template <
+    std::unsigned_integral DistanceType = std::uint16_t,
+    typename Graph
+  >
+  static DenseMatrix<DistanceType>
+  SolveIndex(
+      const Graph& graph,
+      std::span<const typename Graph::IndexType> sources,
+      Spec spec = {}
+  ) requires IndexedGraphConcept<Graph> {
+    DenseMatrix<DistanceType> matrix(
+        sources.size(),
+        graph.NodeCount(),
+        kUnreached<DistanceType>
+    );
+
+    const std::size_t batches = (sources.size() + width - 1) / width;
+    const std::size_t threads = std::min(ThreadCount(spec.threads),
+                                         std::max<std::size_t>(1, batches));
+    std::atomic<std::size_t> next = 0;
+
+    ParallelRun(threads, [&](std::size_t) {
+      Workspace workspace(graph.NodeCount());
+
+      for (std::size_t batch = next++; batch < batches; batch = next++) {
+        const std::size_t lo = batch * width;
+        const std::size_t hi = std::min(lo + width, sources.size());
+        ImplSolve(graph, sources.subspan(lo, hi - lo), lo, workspace, matrix);
+      }
+    });
+
+    return matrix;
+  }
+
+ private:
+  ///
+  /// One bit per source of a batch.
+  ///
+  struct Lanes {
+    std::array<std::uint64_t, width / 64> words = {};
+
+    bool
+    Any() const {
+      std::uint64_t any = 0;
+      for (const auto word: words)
+        any |= word;
+      return any != 0;
+    }
+
+    void
+    Set(std::size_t lane) {
+      words[lane / 64] |= std::uint64_t(1) << (lane % 64);
+    }
+
+    Lanes&
+    operator|=(const Lanes& other) {
+      for (std::size_t n = 0; n < words.size(); ++n)
+        words[n] |= other.words[n];
+      return *this;
+    }
+
+    ///
+    /// Return the bits of `this` which are not in `other`.
+    ///
+    Lanes
+    Without(const Lanes& other) const {
+      Lanes lanes;
+      for (std::size_t n = 0; n < words.size(); ++n)
+        lanes.words[n] = words[n] & ~other.words[n];
+      return lanes;
+    }
+
+    ///
+    /// Call `func(lane)` for every set bit.
+    ///
+    template <typename Func>
+    void
+    ForEach(Func&& func) const {
+      for (std::size_t n = 0; n < words.size(); ++n)
+        for (std::uint64_t word = words[n]; word != 0; word &= word - 1)
+          func(n * 64 + std::countr_zero(word));
+    }
+  };
+
+  ///
+  /// Per thread scratch state, reused between batches.
+  ///
+  struct Workspace {
+    explicit Workspace(std::size_t count)
+      : seen(count),
+        visit(count),
+        visit_next(count)
+    {}
+
+    std::vector<Lanes> seen;
+    std::vector<Lanes> visit;
+    std::vector<Lanes> visit_next;
+    std::vector<std::uint32_t> active;
+    std::vector<std::uint32_t> active_next;
+  };
+
+  ///
+  /// Search from one batch of at most `width` sources, writing rows
+  /// `[row, row + sources.size())` of `matrix`.
+  ///
+  template <typename Graph, typename DistanceType>
+  static void
+  ImplSolve(
+      const Graph& graph,
+      std::span<const typename Graph::IndexType> sources,
+      std::size_t row,
+      Workspace& workspace,
+      DenseMatrix<DistanceType>& matrix
+  ) {
+    auto& seen        = workspace.seen;
+    auto& visit       = workspace.visit;
+    auto& visit_next  = workspace.visit_next;
+    auto& active      = workspace.active;
+    auto& active_next = workspace.active_next;
+
+    std::fill(seen.begin(), seen.end(), Lanes{});
+    active.clear();
+
+    for (std::size_t lane = 0; lane < sources.size(); ++lane) {
+      const auto index = sources[lane];
+      if (!visit[index].Any())
+        active.push_back(index);
+
+      seen[index].Set(lane);
+      visit[index].Set(lane);
+      matrix.At(row + lane, index) = 0;
+    }
+
+    for (DistanceType level = 1;
+         !active.empty() && level < kUnreached<DistanceType>;
+         ++level) {
+      // Push every visiting source of a node to its neighbors at once.
+      active_next.clear();
+      for (const auto node_index: active) {
+        for (const auto& neigh: graph.IndexNeighbors(node_index)) {
+          if (!visit_next[neigh.index].Any())
+            active_next.push_back(neigh.index);
+          visit_next[neigh.index] |= visit[node_index];
+        }
+        visit[node_index] = Lanes{};
+      }
+
+      // Keep only the sources which see a node for the first time.
+      active.clear();
+      for (const auto node_index: active_next) {
+        const Lanes fresh = visit_next[node_index].Without(seen[node_index]);
+        visit_next[node_index] = Lanes{};
+        if (!fresh.Any())
+          continue;
+
+        seen[node_index] |= fresh;
+        visit[node_index] = fresh;
+        active.push_back(node_index);
+        fresh.ForEach([&](std::size_t lane) {
+          matrix.At(row + lane, node_index) = level;
+        });
+      }
+    }
 
+    // Clean up after a search cut short by the distance type.
+    for (const auto node_index: active)
+      visit[node_index] = Lanes{};
+  }
+};
 
+///
+/// @class MultiSourceBfs
+///
+/// Bit-parallel multi-source breadth first search over 64 sources at a time.
+///
+using MultiSourceBfs = BasicMultiSourceBfs<>;
 } // ns search
 
 #endif // SEARCH_ALGORITHM_VISIT_HH_
@@ -0,0 +1,214 @@
+#ifndef SEARCH_ALGORITHM_WORKSPACE_HH_
+#define SEARCH_ALGORITHM_WORKSPACE_HH_
+
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "search/algorithm/common.hh"
+#include "search/algorithm/heap.hh"
+#include "search/graph/common.hh"
+
+namespace search {
+///
+/// @class  DjikstraWorkspace
+/// @tparam Graph       Template for the graph the workspace is sized for.
+/// @tparam HeapPolicy  Priority queue used to order the frontier, see
+///                     `DefaultHeapPolicy`.
+///
+/// Pre-sized scratch state for single source searches: a tentative
+/// distance, parent and settled flag per node, and a heap.
+///
+/// Labels are stamped with a generation counter, so `Reset` only bumps the
+/// counter instead of touching every node, and a label from an older
+/// generation reads as unreached.  Repeated queries against the same graph
+/// therefore allocate nothing.  A workspace must not be shared between
+/// threads.
+///
+template <typename Graph, typename HeapPolicy = DefaultHeapPolicy>
+class DjikstraWorkspace {
+ public:
+  using NodeType  = typename Graph::NodeType;
+  using EdgeType  = typename Graph::EdgeType;
+  using IndexType = typename Graph::IndexType;
+  using Heap      = typename HeapPolicy::template Heap<EdgeType, IndexType>;
+
+  /// Parent of the start node and of unreached nodes.
+  static constexpr IndexType kNone = std::numeric_limits<IndexType>::max();
+
+  ///
+  /// @param graph Graph the workspace will be used with.
+  ///
+  explicit DjikstraWorkspace(const Graph& graph)
+    : sentinal(graph.DefaultValue()),
+      labels(graph.NodeCount()),
+      heap(graph.NodeCount())
+  {}
+
+  DjikstraWorkspace(DjikstraWorkspace&&) = default;
+
+  DjikstraWorkspace&
+  operator=(DjikstraWorkspace&&) = default;
+
+  ///
+  /// Return the number of nodes the workspace was sized for.
+  ///
+  std::size_t
+  NodeCount() const {
+    return labels.size();
+  }
+
+  ///
+  /// Invalidate every label and empty the heap, ahead of a new search.
+  ///
+  void
+  Reset() {
+    heap.Clear();
+    if (++generation == 0) {
+      // Wrapped, stale stamps could now look current.
+      for (auto& label: labels)
+        label.reached = label.settled = 0;
+      generation = 1;
+    }
+  }
+
+  ///
+  /// @param index Dense index of the node.
+  ///
+  /// Return true if the last search assigned `index` a distance.
+  ///
+  bool
+  Reached(IndexType index) const {
+    assert(index < labels.size());
+    return labels[index].reached == generation;
+  }
+
+  ///
+  /// @param index Dense index of the node.
+  ///
+  /// Return true if the last search settled `index`, its distance is final.
+  ///
+  bool
+  Settled(IndexType index) const {
+    assert(index < labels.size());
+    return labels[index].settled == generation;
+  }
+
+  ///
+  /// @param index Dense index of the node.
+  ///
+  /// Return the distance found by the last search, or the graph
+  /// `DefaultValue()` if it did not reach `index`.
+  ///
+  EdgeType
+  Distance(IndexType index) const {
+    return Reached(index) ? labels[index].dist : sentinal;
+  }
+
+  ///
+  /// @param index Dense index of the node.
+  ///
+  /// Return the node `index` was reached from, or `kNone`.
+  ///
+  IndexType
+  Parent(IndexType index) const {
+    return Reached(index) ? labels[index].parent : kNone;
+  }
+
+  ///
+  /// @param graph  The graph the last search ran on.
+  /// @param target Dense index of the end of the path.
+  ///
+  /// Return the path to `target` by following parents back to the start.
+  /// The hops are counted first, so the route is a single allocation.
+  ///
+  ShortestPath<NodeType, EdgeType>
+  Path(const Graph& graph, IndexType target) const {
+    ShortestPath<NodeType, EdgeType> path{Distance(target), {}};
+    if (!Reached(target))
+      return path;
+
+    std::size_t hops = 0;
+    for (IndexType index = target; index != kNone; index = labels[index].parent)
+      ++hops;
+
+    path.nodes.resize(hops);
+    IndexType index = target;
+    for (std::size_t n = hops; n-- > 0; index = labels[index].parent)
+      path.nodes[n] = graph.Node(index);
+
+    return path;
+  }
+
+  ///
+  /// @param index Dense index of the start node.
+  ///
+  /// Label `index` with a distance of zero and no parent.
+  ///
+  void
+  Start(IndexType index) {
+    assert(index < labels.size());
+    labels[index] = {EdgeType(0), kNone, generation, 0};
+  }
+
+  ///
+  /// @param index  Dense index of the node.
+  /// @param dist   Candidate distance.
+  /// @param parent Node the candidate distance comes from.
+  ///
+  /// Lower the label of `index` to `dist`, an unreached node counts as
+  /// `DefaultValue()`.  Returns true if it improved.
+  ///
+  bool
+  Relax(IndexType index, EdgeType dist, IndexType parent) {
+    assert(index < labels.size());
+    Label& label = labels[index];
+    if (!(dist < (label.reached == generation ? label.dist : sentinal)))
+      return false;
+
+    label.dist    = dist;
+    label.parent  = parent;
+    label.reached = generation;
+    return true;
+  }
+
+  ///
+  /// @param index Dense index of the node.
+  ///
+  /// Mark `index` settled.  Returns false if it already was.
+  ///
+  bool
+  Settle(IndexType index) {
+    assert(index < labels.size());
+    if (labels[index].settled == generation)
+      return false;
+
+    labels[index].settled = generation;
+    return true;
+  }
+
+  ///
+  /// Return the heap, empty after `Reset`.
+  ///
+  Heap&
+  Queue() {
+    return heap;
+  }
+
+ private:
+  struct Label {
+    EdgeType      dist;
+    IndexType     parent;
+    std::uint32_t reached = 0;
+    std::uint32_t settled = 0;
+  };
+
+  EdgeType           sentinal;
+  std::uint32_t      generation = 1;
+  std::vector<Label> labels;
+  Heap               heap;
+};
+} // ns search
+
+#endif // SEARCH_ALGORITHM_WORKSPACE_HH_
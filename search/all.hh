@@ -13,12 +13,27 @@ namespace search {
 #include "matrix/dense.hh"
 #include "matrix/sparse_map.hh"
 #include "matrix/common.hh"
+#include "matrix/tropical.hh"
+#include "matrix/fixed_point.hh"
+#include "graph/common.hh"
 #include "graph/neighbor_graph.hh"
+#include "graph/compressed_neighbor_graph.hh"
+#include "graph/mapped_neighbor_graph.hh"
+#include "graph/edge_list_reader.hh"
+#include "parallel/common.hh"
 #include "algorithm/bellman_ford.hh"
 #include "algorithm/common.hh"
+#include "algorithm/heap.hh"
 #include "algorithm/visit.hh"
 #include "algorithm/floyd_warshall.hh"
+#include "algorithm/johnson.hh"
+#include "algorithm/repeated_squaring.hh"
+#include "algorithm/incremental_update.hh"
 #include "algorithm/djikstra.hh"
+#include "algorithm/astar.hh"
+#include "algorithm/contraction_hierarchy.hh"
+#include "algorithm/landmarks.hh"
+#include "algorithm/delta_stepping.hh"
 #include "algorithm/knapsack.hh"
 
 
@@ -0,0 +1,227 @@
+#ifndef SEARCH_GRAPH_COMMON_HH_
+#define SEARCH_GRAPH_COMMON_HH_
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace search {
+///
+/// @struct IndexEdge
+/// @tparam IndexType Dense node index type.
+/// @tparam EdgeType  What data type is being stored in the edge.
+///
+/// An edge which refers to its destination by dense node index instead of by
+/// `NodeType`.
+///
+template <typename IndexType, typename EdgeType>
+struct IndexEdge {
+  IndexType index;
+  EdgeType  edge;
+};
+
+///
+/// @struct NodeEdge
+/// @tparam NodeType What data type is being stored in the graph.
+/// @tparam EdgeType What data type is being stored in the edge.
+///
+/// An edge which refers to its destination by a reference into the node
+/// table of the graph it came from.
+///
+template <typename NodeType, typename EdgeType>
+struct NodeEdge {
+  const NodeType& node;
+  EdgeType        edge;
+};
+
+///
+/// @class  IndexEdgeRange
+/// @tparam IndexType Dense node index type.
+/// @tparam EdgeType  What data type is being stored in the edge.
+///
+/// A non-owning view over the out-edges of a single node in a graph which
+/// stores its targets and weights as two parallel arrays.
+///
+template <typename IndexType, typename EdgeType>
+class IndexEdgeRange {
+ public:
+  using value_type = IndexEdge<IndexType, EdgeType>;
+
+  class Iterator {
+   public:
+    Iterator(const IndexType* target, const EdgeType* weight)
+      : target(target),
+        weight(weight)
+    {}
+
+    value_type
+    operator*() const {
+      return {*target, *weight};
+    }
+
+    Iterator&
+    operator++() {
+      ++target;
+      ++weight;
+      return *this;
+    }
+
+    bool
+    operator==(const Iterator& other) const {
+      return target == other.target;
+    }
+
+   private:
+    const IndexType* target;
+    const EdgeType*  weight;
+  };
+
+  IndexEdgeRange(
+      const IndexType* targets,
+      const EdgeType* weights,
+      std::size_t count
+  ) : targets(targets),
+      weights(weights),
+      count(count)
+  {}
+
+  Iterator
+  begin() const {
+    return Iterator(targets, weights);
+  }
+
+  Iterator
+  end() const {
+    return Iterator(targets + count, weights + count);
+  }
+
+  ///
+  /// Return the number of edges in the view.
+  ///
+  std::size_t
+  size() const {
+    return count;
+  }
+
+  ///
+  /// Return true if the view contains no edges.
+  ///
+  bool
+  empty() const {
+    return count == 0;
+  }
+
+ private:
+  const IndexType* targets;
+  const EdgeType*  weights;
+  std::size_t      count;
+};
+
+///
+/// @class  NodeEdgeRange
+/// @tparam NodeType  What data type is being stored in the graph.
+/// @tparam Range     Underlying range of `IndexEdge` like elements.
+///
+/// Adapts a range of index edges into a range of `NodeEdge`, translating
+/// every target index through the node table of the graph.  This is what
+/// allows index based graphs to be walked with `NodeType` semantics.
+///
+template <typename NodeType, typename Range>
+class NodeEdgeRange {
+ private:
+  using BaseIterator = decltype(std::declval<const Range&>().begin());
+  using EdgeType     = decltype((*std::declval<BaseIterator>()).edge);
+
+ public:
+  using value_type = NodeEdge<NodeType, EdgeType>;
+
+  class Iterator {
+   public:
+    Iterator(BaseIterator base, const NodeType* nodes)
+      : base(base),
+        nodes(nodes)
+    {}
+
+    value_type
+    operator*() const {
+      const auto& elem = *base;
+      return {nodes[elem.index], elem.edge};
+    }
+
+    Iterator&
+    operator++() {
+      ++base;
+      return *this;
+    }
+
+    bool
+    operator==(const Iterator& other) const {
+      return base == other.base;
+    }
+
+   private:
+    BaseIterator    base;
+    const NodeType* nodes;
+  };
+
+  NodeEdgeRange(Range range, const NodeType* nodes)
+    : range(range),
+      nodes(nodes)
+  {}
+
+  Iterator
+  begin() const {
+    return Iterator(range.begin(), nodes);
+  }
+
+  Iterator
+  end() const {
+    return Iterator(range.end(), nodes);
+  }
+
+  ///
+  /// Return the number of edges in the view.
+  ///
+  std::size_t
+  size() const {
+    return range.size();
+  }
+
+  ///
+  /// Return true if the view contains no edges.
+  ///
+  bool
+  empty() const {
+    return range.empty();
+  }
+
+ private:
+  Range           range;
+  const NodeType* nodes;
+};
+
+///
+/// This is a C++ concept which describes a graph that can be walked purely
+/// by dense node index.  Every solver is written against this concept;
+/// `NodeType` is only consulted to translate the start node into an index
+/// and to build the node map of the returned solution.
+///
+template <typename Graph>
+concept IndexedGraphConcept =
+  requires(
+      const Graph& graph,
+      const typename Graph::NodeType& node,
+      typename Graph::IndexType index
+  ) {
+  { graph.NodeCount()    } -> std::convertible_to<std::size_t>;
+  { graph.DefaultValue() } -> std::convertible_to<typename Graph::EdgeType>;
+  { graph.Index(node)    } -> std::convertible_to<typename Graph::IndexType>;
+  { graph.Node(index)    } -> std::convertible_to<const typename Graph::NodeType&>;
+  { graph.BuildNodeMap() };
+  { (*graph.IndexNeighbors(index).begin()).index };
+  { (*graph.IndexNeighbors(index).begin()).edge  };
+};
+} // ns search
+
+#endif // SEARCH_GRAPH_COMMON_HH_
@@ -0,0 +1,239 @@
+#ifndef SEARCH_GRAPH_COMPRESSED_NEIGHBOR_GRAPH_HH_
+#define SEARCH_GRAPH_COMPRESSED_NEIGHBOR_GRAPH_HH_
+
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "search/graph/common.hh"
+#include "search/graph/neighbor_graph.hh"
+
+namespace search {
+///
+/// @class  CompressedNeighborGraph
+/// @tparam NodeType_  What data type is being stored in this graph.
+/// @tparam EdgeType_  What data type is being stored in the edge.
+///
+/// A read-only neighbor graph stored in compressed sparse row form.  Every
+/// node is given a dense `IndexType` id, and the out-edges of node `i` are
+/// the contiguous run `[offsets[i], offsets[i + 1])` of the `targets` and
+/// `weights` arrays.
+///
+/// It exposes the same surface as `NeighborGraph`, so any solver which can
+/// consume a `NeighborGraph` can consume this as well.
+///
+template <typename NodeType_, typename EdgeType_>
+class CompressedNeighborGraph {
+ public:
+  using NodeType      = NodeType_;
+  using EdgeType      = EdgeType_;
+  using IndexType     = std::uint32_t;
+  using OffsetType    = std::uint64_t;
+  using NodeMap       = std::unordered_map<NodeType, std::size_t>;
+  using IndexEdgeList = IndexEdgeRange<IndexType, EdgeType>;
+  using EdgeList      = NodeEdgeRange<NodeType, IndexEdgeList>;
+
+  ///
+  /// Construct an empty graph.
+  ///
+  CompressedNeighborGraph()
+    : sentinal(std::numeric_limits<EdgeType>::max()),
+      offsets(1, 0)
+  {}
+
+  ///
+  /// @param graph Source graph to compress.
+  ///
+  /// Freeze a `NeighborGraph` into compressed form in a single pass over its
+  /// adjacency.
+  ///
+  explicit CompressedNeighborGraph(const NeighborGraph<NodeType, EdgeType>& graph)
+    : sentinal(graph.DefaultValue()),
+      nodes(graph.Nodes()),
+      node_map(graph.BuildNodeMap())
+  {
+    assert(nodes.size() < std::numeric_limits<IndexType>::max());
+
+    std::size_t edge_count = 0;
+    for (IndexType idx = 0; idx < nodes.size(); ++idx)
+      edge_count += graph.IndexNeighbors(idx).size();
+
+    offsets.reserve(nodes.size() + 1);
+    targets.reserve(edge_count);
+    weights.reserve(edge_count);
+    offsets.push_back(0);
+
+    for (IndexType idx = 0; idx < nodes.size(); ++idx) {
+      for (const auto& neigh: graph.IndexNeighbors(idx)) {
+        targets.push_back(neigh.index);
+        weights.push_back(neigh.edge);
+      }
+
+      offsets.push_back(targets.size());
+    }
+  }
+
+  CompressedNeighborGraph(CompressedNeighborGraph&&) = default;
+
+  CompressedNeighborGraph&
+  operator=(CompressedNeighborGraph&&) = default;
+
+  ///
+  /// Return the default value for the matrix, this is the `sentinal` of the
+  /// graph this was built from.
+  ///
+  EdgeType
+  DefaultValue() const {
+    return sentinal;
+  }
+
+  ///
+  /// Build a node map.
+  ///
+  NodeMap
+  BuildNodeMap() const {
+    return node_map;
+  }
+
+  ///
+  /// Return a list of nodes, ordered by their index.
+  ///
+  const std::vector<NodeType>&
+  Nodes() const {
+    return nodes;
+  }
+
+  ///
+  /// Return the number of unique nodes.
+  ///
+  std::size_t
+  NodeCount() const {
+    return nodes.size();
+  }
+
+  ///
+  /// Return the number of stored (directed) edges.
+  ///
+  std::size_t
+  EdgeCount() const {
+    return targets.size();
+  }
+
+  ///
+  /// @param node Node to look up.
+  ///
+  /// Return the dense index of a node.
+  ///
+  IndexType
+  Index(const NodeType& node) const {
+    return node_map.at(node);
+  }
+
+  ///
+  /// @param index Dense index to look up.
+  ///
+  /// Return the node stored at a dense index.
+  ///
+  const NodeType&
+  Node(IndexType index) const {
+    assert(index < nodes.size());
+    return nodes[index];
+  }
+
+  ///
+  /// @param node Node to get edges for.
+  ///
+  /// Fetch a view of the edges for a provided node.
+  ///
+  EdgeList
+  Neighbors(const NodeType& node) const {
+    return EdgeList(IndexNeighbors(Index(node)), nodes.data());
+  }
+
+  ///
+  /// @param index Dense index of the node to get edges for.
+  ///
+  /// Fetch a view of the edges for a provided node index.  No hashing is
+  /// performed.
+  ///
+  IndexEdgeList
+  IndexNeighbors(IndexType index) const {
+    assert(index < nodes.size());
+    return IndexEdgeList(
+        targets.data() + offsets[index],
+        weights.data() + offsets[index],
+        offsets[index + 1] - offsets[index]
+    );
+  }
+
+  ///
+  /// Return the transposed graph: every edge `u -> v` becomes `v -> u`.  Node
+  /// indices are preserved, so index based searches on the graph and its
+  /// reverse can be combined.
+  ///
+  CompressedNeighborGraph
+  Reverse() const {
+    CompressedNeighborGraph reverse;
+    reverse.sentinal = sentinal;
+    reverse.nodes    = nodes;
+    reverse.node_map = node_map;
+    reverse.offsets.assign(nodes.size() + 1, 0);
+    reverse.targets.resize(targets.size());
+    reverse.weights.resize(weights.size());
+
+    for (const IndexType target: targets)
+      ++reverse.offsets[target + 1];
+    for (std::size_t idx = 0; idx < nodes.size(); ++idx)
+      reverse.offsets[idx + 1] += reverse.offsets[idx];
+
+    std::vector<OffsetType> cursor(reverse.offsets.begin(),
+                                   reverse.offsets.end() - 1);
+    for (IndexType idx = 0; idx < nodes.size(); ++idx) {
+      for (OffsetType n = offsets[idx]; n < offsets[idx + 1]; ++n) {
+        const OffsetType slot = cursor[targets[n]]++;
+        reverse.targets[slot] = idx;
+        reverse.weights[slot] = weights[n];
+      }
+    }
+
+    return reverse;
+  }
+
+  ///
+  /// Return the raw CSR offsets array, of size `NodeCount() + 1`.
+  ///
+  std::span<const OffsetType>
+  Offsets() const {
+    return offsets;
+  }
+
+  ///
+  /// Return the raw CSR targets array, of size `EdgeCount()`.
+  ///
+  std::span<const IndexType>
+  Targets() const {
+    return targets;
+  }
+
+  ///
+  /// Return the raw CSR weights array, of size `EdgeCount()`.
+  ///
+  std::span<const EdgeType>
+  Weights() const {
+    return weights;
+  }
+
+ private:
+  EdgeType                sentinal;
+  std::vector<NodeType>   nodes;
+  NodeMap                 node_map;
+  std::vector<OffsetType> offsets;
+  std::vector<IndexType>  targets;
+  std::vector<EdgeType>   weights;
+};
+} // ns search
+
+#endif // SEARCH_GRAPH_COMPRESSED_NEIGHBOR_GRAPH_HH_
@@ -0,0 +1,303 @@
+#ifndef SEARCH_GRAPH_EDGE_LIST_READER_HH_
+#define SEARCH_GRAPH_EDGE_LIST_READER_HH_
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "search/graph/neighbor_graph.hh"
+#include "search/parallel/common.hh"
+
+namespace search {
+///
+/// @class EdgeListError
+///
+/// Thrown when an edge list file cannot be read or is malformed.
+///
+class EdgeListError : public std::runtime_error {
+ public:
+  explicit EdgeListError(const std::string& what)
+    : std::runtime_error("EdgeListError: " + what) {}
+};
+
+///
+/// @enum EdgeListFormat
+/// On-disk layout of an edge list.
+///
+enum class EdgeListFormat {
+  /// One `from to [weight]` edge per line, separated by blanks.  Empty
+  /// lines and lines starting with `#` or `%` are skipped; a missing weight
+  /// is read as `1`.
+  TEXT   = 1,
+  /// Packed `{NodeType from; NodeType to; EdgeType weight;}` records in host
+  /// byte order with no padding.
+  BINARY = 2,
+};
+
+///
+/// @class EdgeListReader
+///
+/// Bulk loader for large edge list files.  The file is mapped, split into
+/// one chunk per thread (on line boundaries for text), and each chunk is
+/// parsed in parallel into a thread local buffer.  The buffers are then
+/// merged into a `NeighborGraph` whose adjacency is reserved up-front from
+/// the exact node degrees, so no edge vector is ever reallocated.
+///
+/// Edges are inserted in file order, so the result is identical to calling
+/// `AddEdge` for every line.
+///
+class EdgeListReader {
+ public:
+  ///
+  /// @struct Spec
+  ///
+  /// Specification for reading an edge list.
+  ///
+  struct Spec {
+    EdgeListFormat format  = EdgeListFormat::TEXT;
+    std::size_t    threads = 0;
+  };
+
+  /// @tparam NodeType  Node type, must be arithmetic.
+  /// @tparam EdgeType  Edge type, must be arithmetic.
+  /// @param  path        File to read.
+  /// @param  graph_spec  Specification of the graph to build.
+  /// @param  spec        Specification of the file.
+  ///
+  /// Read an edge list into a new graph.
+  template <typename NodeType, typename EdgeType>
+  static NeighborGraph<NodeType, EdgeType>
+  Read(
+      const std::string& path,
+      typename NeighborGraph<NodeType, EdgeType>::Spec graph_spec = {},
+      Spec spec = {}
+  ) requires std::is_arithmetic_v<NodeType>
+          && std::is_arithmetic_v<EdgeType> {
+    using Graph     = NeighborGraph<NodeType, EdgeType>;
+    using IndexType = typename Graph::IndexType;
+    using Buffer    = std::vector<Record<NodeType, EdgeType>>;
+
+    Mapping file(path);
+    const std::size_t threads = ThreadCount(spec.threads);
+    std::vector<Buffer> buffers(threads);
+
+    if (spec.format == EdgeListFormat::TEXT)
+      ParseText(file, buffers);
+    else
+      ParseBinary(file, buffers);
+
+    // Intern in file order, keeping the indices so the adjacency can be
+    // sized exactly before any edge is inserted.
+    Graph graph(graph_spec);
+    std::vector<std::size_t> degree;
+    std::vector<std::vector<std::pair<IndexType, IndexType>>> ids(threads);
+
+    for (std::size_t t = 0; t < threads; ++t) {
+      ids[t].reserve(buffers[t].size());
+
+      for (const auto& record: buffers[t]) {
+        const IndexType idx_fr = graph.Intern(record.fr);
+        const IndexType idx_to = graph.Intern(record.to);
+        ids[t].push_back({idx_fr, idx_to});
+
+        degree.resize(graph.NodeCount(), 0);
+        ++degree[idx_fr];
+        if (!graph_spec.directed)
+          ++degree[idx_to];
+      }
+    }
+
+    for (IndexType idx = 0; idx < graph.NodeCount(); ++idx)
+      graph.ReserveEdges(idx, degree[idx]);
+
+    for (std::size_t t = 0; t < threads; ++t) {
+      for (std::size_t n = 0; n < ids[t].size(); ++n)
+        graph.AddIndexEdge(ids[t][n].first, ids[t][n].second,
+                           buffers[t][n].edge);
+
+      Buffer().swap(buffers[t]);
+    }
+
+    return graph;
+  }
+
+ private:
+  template <typename NodeType, typename EdgeType>
+  struct Record {
+    NodeType fr;
+    NodeType to;
+    EdgeType edge;
+  };
+
+  ///
+  /// @struct Mapping
+  ///
+  /// Read-only private mapping of a whole file.
+  ///
+  struct Mapping {
+    explicit Mapping(const std::string& path) {
+      int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+      if (fd < 0)
+        throw EdgeListError("cannot open " + path);
+
+      struct stat st;
+      if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        throw EdgeListError("cannot stat " + path);
+      }
+
+      size = st.st_size;
+      if (size != 0) {
+        void* addr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr == MAP_FAILED) {
+          ::close(fd);
+          throw EdgeListError("cannot map " + path);
+        }
+
+        ::madvise(addr, size, MADV_SEQUENTIAL);
+        data = static_cast<const char*>(addr);
+      }
+
+      ::close(fd);
+    }
+
+    ~Mapping() {
+      if (data)
+        ::munmap(const_cast<char*>(data), size);
+    }
+
+    Mapping(const Mapping&) = delete;
+    Mapping&
+    operator=(const Mapping&) = delete;
+
+    const char* data = nullptr;
+    std::size_t size = 0;
+  };
+
+  static const char*
+  SkipBlank(const char* cur, const char* end) {
+    while (cur < end && (*cur == ' ' || *cur == '\t' || *cur == '\r'))
+      ++cur;
+    return cur;
+  }
+
+  template <typename Type>
+  static const char*
+  ParseField(const char* cur, const char* end, Type& value) {
+    cur = SkipBlank(cur, end);
+    auto [ptr, ec] = std::from_chars(cur, end, value);
+    if (ec != std::errc() || ptr == cur)
+      return nullptr;
+
+    return ptr;
+  }
+
+  template <typename NodeType, typename EdgeType>
+  static void
+  ParseText(
+      const Mapping& file,
+      std::vector<std::vector<Record<NodeType, EdgeType>>>& buffers
+  ) {
+    const std::size_t threads = buffers.size();
+    const char* const base = file.data;
+    const char* const last = file.data + file.size;
+
+    // Move every chunk start forward to the beginning of a line.
+    std::vector<const char*> starts(threads + 1, last);
+    for (std::size_t t = 0; t < threads; ++t) {
+      const char* start = base + file.size * t / threads;
+      while (t != 0 && start < last && start[-1] != '\n')
+        ++start;
+      starts[t] = start;
+    }
+
+    ParallelRun(threads, [&](std::size_t t) {
+      auto& buffer = buffers[t];
+      const char* cur = starts[t];
+      const char* end = starts[t + 1];
+
+      // Rough guess of ~16 bytes per line, avoids most regrowth.
+      buffer.reserve((end - cur) / 16);
+
+      while (cur < end) {
+        cur = SkipBlank(cur, end);
+        if (cur == end)
+          break;
+
+        if (*cur == '\n') {
+          ++cur;
+          continue;
+        }
+
+        if (*cur == '#' || *cur == '%') {
+          const void* eol = std::memchr(cur, '\n', end - cur);
+          cur = eol ? static_cast<const char*>(eol) + 1 : end;
+          continue;
+        }
+
+        Record<NodeType, EdgeType> record;
+        const char* line = cur;
+
+        cur = ParseField(cur, end, record.fr);
+        if (cur)
+          cur = ParseField(cur, end, record.to);
+        if (cur) {
+          cur = SkipBlank(cur, end);
+          if (cur == end || *cur == '\n')
+            record.edge = EdgeType(1);
+          else
+            cur = ParseField(cur, end, record.edge);
+        }
+        if (cur)
+          cur = SkipBlank(cur, end);
+
+        if (!cur || (cur != end && *cur != '\n'))
+          throw EdgeListError(
+              "malformed line at byte " + std::to_string(line - base));
+
+        buffer.push_back(record);
+      }
+    });
+  }
+
+  template <typename NodeType, typename EdgeType>
+  static void
+  ParseBinary(
+      const Mapping& file,
+      std::vector<std::vector<Record<NodeType, EdgeType>>>& buffers
+  ) {
+    constexpr std::size_t kRecordSize = 2 * sizeof(NodeType) + sizeof(EdgeType);
+
+    if (file.size % kRecordSize != 0)
+      throw EdgeListError(
+          "size is not a multiple of " + std::to_string(kRecordSize));
+
+    ParallelFor(buffers.size(), 0, file.size / kRecordSize,
+        [&](std::size_t t, std::size_t lo, std::size_t hi) {
+          auto& buffer = buffers[t];
+          buffer.resize(hi - lo);
+
+          const char* cur = file.data + lo * kRecordSize;
+          for (auto& record: buffer) {
+            std::memcpy(&record.fr,   cur, sizeof(NodeType));
+            cur += sizeof(NodeType);
+            std::memcpy(&record.to,   cur, sizeof(NodeType));
+            cur += sizeof(NodeType);
+            std::memcpy(&record.edge, cur, sizeof(EdgeType));
+            cur += sizeof(EdgeType);
+          }
+        });
+  }
+};
+} // ns search
+
+#endif // SEARCH_GRAPH_EDGE_LIST_READER_HH_
@@ -0,0 +1,534 @@
+#ifndef SEARCH_GRAPH_MAPPED_NEIGHBOR_GRAPH_HH_
+#define SEARCH_GRAPH_MAPPED_NEIGHBOR_GRAPH_HH_
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "search/graph/common.hh"
+
+namespace search {
+///
+/// @class MappedGraphError
+///
+/// Thrown when a binary graph file cannot be written, opened, or does not
+/// match the layout expected by the `MappedNeighborGraph` reading it.
+///
+class MappedGraphError : public std::runtime_error {
+ public:
+  explicit MappedGraphError(const std::string& what)
+    : std::runtime_error("MappedGraphError: " + what) {}
+};
+
+///
+/// @struct MappedGraphHeader
+///
+/// On-disk header of the binary graph format.  The file is laid out as:
+///
+///   header | nodes[N] | order[N] | offsets[N + 1] | targets[E] | weights[E]
+///
+/// where every section starts on a `kAlignment` boundary, `order` is the
+/// permutation of node indices sorted by node value (used to look nodes up
+/// without building a hash map), and the last three sections are the CSR
+/// adjacency.  All values are stored in host byte order; `endian` is used to
+/// reject files written on a host of the other byte order.
+///
+struct MappedGraphHeader {
+  static constexpr char          kMagic[8]  = {'S', 'R', 'C', 'H', 'G', 'R', 'P', 'H'};
+  static constexpr std::uint32_t kVersion   = 1;
+  static constexpr std::uint32_t kEndian    = 0x01020304;
+  static constexpr std::uint64_t kAlignment = 64;
+
+  char          magic[8];
+  std::uint32_t version;
+  std::uint32_t endian;
+  std::uint32_t node_tag;
+  std::uint32_t edge_tag;
+  std::uint32_t reserved[2];
+  std::uint64_t node_count;
+  std::uint64_t edge_count;
+  std::uint64_t sentinal;
+  std::uint64_t nodes_offset;
+  std::uint64_t order_offset;
+  std::uint64_t offsets_offset;
+  std::uint64_t targets_offset;
+  std::uint64_t weights_offset;
+  std::uint64_t file_size;
+
+  ///
+  /// @tparam Type  Type to describe.
+  ///
+  /// Encode the size and kind (unsigned, signed, floating) of a type, so
+  /// that a `float` file is never read back as `int32_t`.
+  ///
+  template <typename Type>
+  static constexpr std::uint32_t
+  Tag() {
+    const std::uint32_t kind = std::is_floating_point_v<Type> ? 2
+                             : std::is_signed_v<Type>         ? 1
+                             : 0;
+    return (kind << 16) | sizeof(Type);
+  }
+};
+
+///
+/// This is a C++ concept for node and edge types which can be stored
+/// in-place in a mapped file.
+///
+template <typename Type>
+concept MappableConcept =
+  std::is_trivially_copyable_v<Type>
+  && std::is_standard_layout_v<Type>
+  && sizeof(Type) <= sizeof(std::uint64_t);
+
+///
+/// @class  MappedNeighborGraph
+/// @tparam NodeType_  What data type is being stored in this graph.
+/// @tparam EdgeType_  What data type is being stored in the edge.
+///
+/// A read-only, zero-copy graph backed by a memory mapped binary file in the
+/// `MappedGraphHeader` format.  Opening a graph costs one `mmap` and a header
+/// check; the adjacency is paged in on first touch.  The contents of the
+/// sections are trusted, see `Validate` for files which may be corrupt.  The
+/// mapping is shared, so several processes mapping the same file share its
+/// physical pages.
+///
+/// It exposes the same surface as `CompressedNeighborGraph`, so it can be
+/// passed to any solver.
+///
+template <typename NodeType_, typename EdgeType_>
+  requires MappableConcept<NodeType_>
+        && MappableConcept<EdgeType_>
+        && std::totally_ordered<NodeType_>
+class MappedNeighborGraph {
+ public:
+  using NodeType      = NodeType_;
+  using EdgeType      = EdgeType_;
+  using IndexType     = std::uint32_t;
+  using OffsetType    = std::uint64_t;
+  using NodeMap       = std::unordered_map<NodeType, std::size_t>;
+  using IndexEdgeList = IndexEdgeRange<IndexType, EdgeType>;
+  using EdgeList      = NodeEdgeRange<NodeType, IndexEdgeList>;
+
+  ///
+  /// @param path  File to map.
+  ///
+  /// Map a file previously written by `Write`.
+  ///
+  explicit MappedNeighborGraph(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+      throw MappedGraphError("cannot open " + path);
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+      ::close(fd);
+      throw MappedGraphError("cannot stat " + path);
+    }
+
+    size = st.st_size;
+    if (size < sizeof(MappedGraphHeader)) {
+      ::close(fd);
+      throw MappedGraphError("truncated header in " + path);
+    }
+
+    base = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+
+    if (base == MAP_FAILED) {
+      base = nullptr;
+      throw MappedGraphError("cannot map " + path);
+    }
+
+    try {
+      Bind(path);
+    } catch (...) {
+      ::munmap(base, size);
+      throw;
+    }
+  }
+
+  MappedNeighborGraph(MappedNeighborGraph&& other)
+    : base(std::exchange(other.base, nullptr)),
+      size(std::exchange(other.size, 0)),
+      header(other.header),
+      nodes(other.nodes),
+      order(other.order),
+      offsets(other.offsets),
+      targets(other.targets),
+      weights(other.weights)
+  {}
+
+  MappedNeighborGraph&
+  operator=(MappedNeighborGraph&& other) {
+    std::swap(base,    other.base);
+    std::swap(size,    other.size);
+    std::swap(header,  other.header);
+    std::swap(nodes,   other.nodes);
+    std::swap(order,   other.order);
+    std::swap(offsets, other.offsets);
+    std::swap(targets, other.targets);
+    std::swap(weights, other.weights);
+    return *this;
+  }
+
+  ~MappedNeighborGraph() {
+    if (base)
+      ::munmap(base, size);
+  }
+
+  ///
+  /// @tparam Graph  Inferred.
+  /// @param  graph  Graph to serialize.
+  /// @param  path   Destination file.
+  ///
+  /// Write any indexed graph to `path` in the binary format.  The file is
+  /// written to a temporary name and renamed into place, so readers never
+  /// observe a partially written graph.
+  ///
+  template <typename Graph>
+  static void
+  Write(const Graph& graph, const std::string& path)
+    requires IndexedGraphConcept<Graph>
+          && std::same_as<typename Graph::NodeType, NodeType>
+          && std::same_as<typename Graph::EdgeType, EdgeType> {
+    const std::uint64_t node_count = graph.NodeCount();
+
+    std::vector<NodeType>   node_table(node_count);
+    std::vector<IndexType>  node_order(node_count);
+    std::vector<OffsetType> node_offsets(node_count + 1, 0);
+
+    for (IndexType idx = 0; idx < node_count; ++idx) {
+      node_table[idx]       = graph.Node(idx);
+      node_offsets[idx + 1] = node_offsets[idx]
+                            + graph.IndexNeighbors(idx).size();
+    }
+
+    std::iota(node_order.begin(), node_order.end(), IndexType(0));
+    std::sort(node_order.begin(), node_order.end(),
+        [&](IndexType a, IndexType b) {
+          return node_table[a] < node_table[b];
+        });
+
+    const std::uint64_t edge_count = node_offsets[node_count];
+
+    MappedGraphHeader hdr = {};
+    std::memcpy(hdr.magic, MappedGraphHeader::kMagic, sizeof(hdr.magic));
+    hdr.version    = MappedGraphHeader::kVersion;
+    hdr.endian     = MappedGraphHeader::kEndian;
+    hdr.node_tag   = MappedGraphHeader::Tag<NodeType>();
+    hdr.edge_tag   = MappedGraphHeader::Tag<EdgeType>();
+    hdr.node_count = node_count;
+    hdr.edge_count = edge_count;
+
+    const EdgeType sentinal = graph.DefaultValue();
+    std::memcpy(&hdr.sentinal, &sentinal, sizeof(sentinal));
+
+    std::uint64_t cursor = sizeof(hdr);
+    auto section = [&](std::uint64_t bytes) {
+      const std::uint64_t offset = Align(cursor);
+      cursor = offset + bytes;
+      return offset;
+    };
+
+    hdr.nodes_offset   = section(node_count * sizeof(NodeType));
+    hdr.order_offset   = section(node_count * sizeof(IndexType));
+    hdr.offsets_offset = section((node_count + 1) * sizeof(OffsetType));
+    hdr.targets_offset = section(edge_count * sizeof(IndexType));
+    hdr.weights_offset = section(edge_count * sizeof(EdgeType));
+    hdr.file_size      = cursor;
+
+    const std::string tmp_path = path + ".tmp";
+    std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+    if (!out)
+      throw MappedGraphError("cannot create " + tmp_path);
+
+    // Never leave a partial temporary behind.
+    try {
+      std::uint64_t written = 0;
+      auto pad = [&](std::uint64_t offset) {
+        static const char padding[MappedGraphHeader::kAlignment] = {};
+        out.write(padding, offset - written);
+        written = offset;
+      };
+      auto emit = [&](const void* data, std::uint64_t bytes) {
+        out.write(static_cast<const char*>(data), bytes);
+        written += bytes;
+      };
+
+      emit(&hdr, sizeof(hdr));
+      pad(hdr.nodes_offset);
+      emit(node_table.data(), node_count * sizeof(NodeType));
+      pad(hdr.order_offset);
+      emit(node_order.data(), node_count * sizeof(IndexType));
+      pad(hdr.offsets_offset);
+      emit(node_offsets.data(), (node_count + 1) * sizeof(OffsetType));
+
+      // Targets and weights are streamed node by node to avoid building a
+      // second copy of the adjacency in memory.
+      pad(hdr.targets_offset);
+      for (IndexType idx = 0; idx < node_count; ++idx) {
+        for (const auto& neigh: graph.IndexNeighbors(idx)) {
+          const IndexType target = neigh.index;
+          emit(&target, sizeof(target));
+        }
+      }
+
+      pad(hdr.weights_offset);
+      for (IndexType idx = 0; idx < node_count; ++idx) {
+        for (const auto& neigh: graph.IndexNeighbors(idx)) {
+          const EdgeType weight = neigh.edge;
+          emit(&weight, sizeof(weight));
+        }
+      }
+
+      out.close();
+      if (!out || written != hdr.file_size)
+        throw MappedGraphError("short write to " + tmp_path);
+
+      if (std::rename(tmp_path.c_str(), path.c_str()) != 0)
+        throw MappedGraphError("cannot rename " + tmp_path + " to " + path);
+    } catch (...) {
+      out.close();
+      std::remove(tmp_path.c_str());
+      throw;
+    }
+  }
+
+  ///
+  /// Return the default value for the matrix, as stored in the file.
+  ///
+  EdgeType
+  DefaultValue() const {
+    EdgeType sentinal;
+    std::memcpy(&sentinal, &header->sentinal, sizeof(sentinal));
+    return sentinal;
+  }
+
+  ///
+  /// Build a node map.  This is the only operation which touches every node.
+  ///
+  NodeMap
+  BuildNodeMap() const {
+    NodeMap node_map;
+    node_map.reserve(nodes.size());
+    for (std::size_t idx = 0; idx < nodes.size(); ++idx)
+      node_map.emplace(nodes[idx], idx);
+
+    return node_map;
+  }
+
+  ///
+  /// Check every section the solvers trust: offsets never decrease, every
+  /// target is a node index, and `order` is the sorted permutation `Index`
+  /// searches.  Opening a graph only checks the header and section sizes,
+  /// so a file from an untrusted source should be validated once before it
+  /// is searched.  This reads, and pages in, the whole file, `O(N + E)`.
+  /// Throws `MappedGraphError` on the first corrupt entry.
+  ///
+  void
+  Validate() const {
+    const std::uint64_t node_count = nodes.size();
+
+    if (!std::is_sorted(offsets.begin(), offsets.end()))
+      throw MappedGraphError("corrupt offsets");
+
+    for (const IndexType target: targets)
+      if (target >= node_count)
+        throw MappedGraphError("corrupt targets");
+
+    // Strictly increasing nodes through in range indices make `order` a
+    // sorted permutation.
+    for (std::size_t n = 0; n < order.size(); ++n)
+      if (order[n] >= node_count
+       || (n > 0 && !(nodes[order[n - 1]] < nodes[order[n]])))
+        throw MappedGraphError("corrupt order");
+  }
+
+  ///
+  /// Return a list of nodes, ordered by their index.
+  ///
+  std::span<const NodeType>
+  Nodes() const {
+    return nodes;
+  }
+
+  ///
+  /// Return the number of unique nodes.
+  ///
+  std::size_t
+  NodeCount() const {
+    return nodes.size();
+  }
+
+  ///
+  /// Return the number of stored (directed) edges.
+  ///
+  std::size_t
+  EdgeCount() const {
+    return targets.size();
+  }
+
+  ///
+  /// @param node Node to look up.
+  ///
+  /// Return the dense index of a node, found by binary search over the
+  /// sorted node order.  Throws `std::out_of_range` if it does not exist.
+  ///
+  IndexType
+  Index(const NodeType& node) const {
+    auto iter = std::lower_bound(order.begin(), order.end(), node,
+        [&](IndexType idx, const NodeType& value) {
+          return nodes[idx] < value;
+        });
+
+    if (iter == order.end() || nodes[*iter] != node)
+      throw std::out_of_range("MappedNeighborGraph::Index");
+
+    return *iter;
+  }
+
+  ///
+  /// @param index Dense index to look up.
+  ///
+  /// Return the node stored at a dense index.
+  ///
+  const NodeType&
+  Node(IndexType index) const {
+    assert(index < nodes.size());
+    return nodes[index];
+  }
+
+  ///
+  /// @param node Node to get edges for.
+  ///
+  /// Fetch a view of the edges for a provided node.
+  ///
+  EdgeList
+  Neighbors(const NodeType& node) const {
+    return EdgeList(IndexNeighbors(Index(node)), nodes.data());
+  }
+
+  ///
+  /// @param index Dense index of the node to get edges for.
+  ///
+  /// Fetch a view of the edges for a provided node index.
+  ///
+  IndexEdgeList
+  IndexNeighbors(IndexType index) const {
+    assert(index < nodes.size());
+    return IndexEdgeList(
+        targets.data() + offsets[index],
+        weights.data() + offsets[index],
+        offsets[index + 1] - offsets[index]
+    );
+  }
+
+  ///
+  /// Return the raw CSR offsets array, of size `NodeCount() + 1`.
+  ///
+  std::span<const OffsetType>
+  Offsets() const {
+    return offsets;
+  }
+
+  ///
+  /// Return the raw CSR targets array, of size `EdgeCount()`.
+  ///
+  std::span<const IndexType>
+  Targets() const {
+    return targets;
+  }
+
+  ///
+  /// Return the raw CSR weights array, of size `EdgeCount()`.
+  ///
+  std::span<const EdgeType>
+  Weights() const {
+    return weights;
+  }
+
+ private:
+  void*                       base = nullptr;
+  std::size_t                 size = 0;
+  const MappedGraphHeader*    header = nullptr;
+  std::span<const NodeType>   nodes;
+  std::span<const IndexType>  order;
+  std::span<const OffsetType> offsets;
+  std::span<const IndexType>  targets;
+  std::span<const EdgeType>   weights;
+
+  static std::uint64_t
+  Align(std::uint64_t offset) {
+    const std::uint64_t align = MappedGraphHeader::kAlignment;
+    return (offset + align - 1) / align * align;
+  }
+
+  ///
+  /// Validate the header against the mapping and bind the section views.
+  ///
+  void
+  Bind(const std::string& path) {
+    header = static_cast<const MappedGraphHeader*>(base);
+
+    if (std::memcmp(header->magic, MappedGraphHeader::kMagic,
+                    sizeof(header->magic)) != 0)
+      throw MappedGraphError("bad magic in " + path);
+    if (header->version != MappedGraphHeader::kVersion)
+      throw MappedGraphError("unsupported version in " + path);
+    if (header->endian != MappedGraphHeader::kEndian)
+      throw MappedGraphError("foreign byte order in " + path);
+    if (header->node_tag != MappedGraphHeader::Tag<NodeType>()
+     || header->edge_tag != MappedGraphHeader::Tag<EdgeType>())
+      throw MappedGraphError("node/edge type mismatch in " + path);
+    if (header->file_size != size)
+      throw MappedGraphError("size mismatch in " + path);
+
+    const std::uint64_t node_count = header->node_count;
+    const std::uint64_t edge_count = header->edge_count;
+    if (node_count > std::numeric_limits<IndexType>::max())
+      throw MappedGraphError("corrupt node count in " + path);
+
+    auto section = [&]<typename Type>(std::uint64_t offset,
+                                      std::uint64_t count,
+                                      std::span<const Type>& view) {
+      if (offset % alignof(Type) != 0
+       || offset > size
+       || count > (size - offset) / sizeof(Type))
+        throw MappedGraphError("corrupt section in " + path);
+
+      const char* bytes = static_cast<const char*>(base) + offset;
+      view = {reinterpret_cast<const Type*>(bytes), count};
+    };
+
+    section(header->nodes_offset,   node_count,     nodes);
+    section(header->order_offset,   node_count,     order);
+    section(header->offsets_offset, node_count + 1, offsets);
+    section(header->targets_offset, edge_count,     targets);
+    section(header->weights_offset, edge_count,     weights);
+
+    if (offsets.front() != 0 || offsets.back() != edge_count)
+      throw MappedGraphError("corrupt offsets in " + path);
+  }
+};
+} // ns search
+
+#endif // SEARCH_GRAPH_MAPPED_NEIGHBOR_GRAPH_HH_
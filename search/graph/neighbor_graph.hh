@@ -1,29 +1,67 @@
 #ifndef SEARCH_GRAPH_NEIGHBOR_GRAPH_HH_
 #define SEARCH_GRAPH_NEIGHBOR_GRAPH_HH_
 
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
 #include <unordered_map>
 #include <vector>
 
+#include "search/algorithm/common.hh"
+#include "search/graph/common.hh"
+#include "search/matrix/dense.hh"
+
 namespace search {
 // Forward declaration.
 template <typename NodeType, typename EdgeType>
 class NeighborGraph;
 
+///
+/// @enum Record
+/// What a solver records in its solution besides distances.
+///
+enum class Record {
+  /// Only distances.
+  DISTANCES    = 1,
+  /// Distances, and the predecessor of every node on its shortest path.
+  PREDECESSORS = 2,
+};
+
 ///
 /// @class  NeighborGraphSolution
 /// @tparam NodeType_   What data type is being stored in this solution.
 /// @tparam MatrixType_ What is the underlying matrix storing data.
+/// @tparam record_     Whether predecessors are stored, see `Record`.
 ///
 /// This class holds a mapped solution for shortest path.  It stores internally
 /// the `Node` mapping to the matrix index.
 ///
-template <typename NodeType_, typename MatrixType_>
+/// With `Record::PREDECESSORS` it also stores a predecessor index matrix of
+/// the same shape as the distances, so routes can be rebuilt with `Path`.
+/// Without it no predecessor storage exists at all.
+///
+template <
+  typename NodeType_,
+  typename MatrixType_,
+  Record record_ = Record::DISTANCES
+>
 class NeighborGraphSolution {
  public:
   using NodeType   = NodeType_;
   using MatrixType = MatrixType_;
   using EdgeType   = MatrixType::Type;
   using NodeMap    = std::unordered_map<NodeType, std::size_t>;
+  using IndexType  = std::uint32_t;
+
+  static constexpr Record record = record_;
+  static constexpr bool   kPredecessors = (record == Record::PREDECESSORS);
+
+  /// Predecessor of a start node, or of a node which was not reached.
+  static constexpr IndexType kNone = std::numeric_limits<IndexType>::max();
+
+  using PredecessorMatrix = DenseMatrix<IndexType>;
 
   NeighborGraphSolution() = default;
 
@@ -38,7 +76,10 @@ class NeighborGraphSolution {
       MatrixType&& edges
   ) : nodes(std::move(nodes)),
       edges(std::move(edges))
-  {}
+  {
+    if constexpr (kPredecessors)
+      InitPredecessors();
+  }
 
   ///
   /// @param nodes         Initialize the node map.
@@ -53,7 +94,10 @@ class NeighborGraphSolution {
       EdgeType default_value
   ) : nodes(nodes),
       edges(all_pairs ? nodes.size() : 1, nodes.size(), default_value)
-  {}
+  {
+    if constexpr (kPredecessors)
+      InitPredecessors();
+  }
 
   NeighborGraphSolution(NeighborGraphSolution&&) = default;
 
@@ -87,6 +131,33 @@ class NeighborGraphSolution {
     return edges.At(nodes.at(fr), nodes.at(to));
   }
 
+  ///
+  /// @param node Path destination.
+  ///
+  /// This assumes that the solution was made without `all_pairs`.  Return
+  /// the shortest path from the start node to `node`.
+  ///
+  ShortestPath<NodeType, EdgeType>
+  Path(const NodeType& node) const requires kPredecessors {
+    assert(edges.Rows() == 1);
+    return ImplPath(0, kNone, nodes.at(node));
+  }
+
+  ///
+  /// @param fr Path source.
+  /// @param to Path destination.
+  ///
+  /// This assumes that the solution was made with `all_pairs`.  Return the
+  /// shortest path from `fr` to `to`.  The route is rebuilt by walking
+  /// predecessors in O(path length), with a single allocation.
+  ///
+  ShortestPath<NodeType, EdgeType>
+  Path(const NodeType& fr, const NodeType& to) const requires kPredecessors {
+    assert(edges.Rows() == edges.Cols());
+    const IndexType index = nodes.at(fr);
+    return ImplPath(index, index, nodes.at(to));
+  }
+
   ///
   /// Return a reference to the edge matrix.
   ///
@@ -103,6 +174,24 @@ class NeighborGraphSolution {
     return edges;
   }
 
+  ///
+  /// Return a reference to the predecessor matrix.  Entry `(row, i)` is the
+  /// index of the node before `i` on the shortest path from the row's start
+  /// node, or `kNone`.
+  ///
+  PredecessorMatrix&
+  Predecessors() requires kPredecessors {
+    return predecessors;
+  }
+
+  ///
+  /// Return a const reference to the predecessor matrix.
+  ///
+  const PredecessorMatrix&
+  Predecessors() const requires kPredecessors {
+    return predecessors;
+  }
+
   ///
   /// Return a reference to the node map.
   ///
@@ -120,14 +209,63 @@ class NeighborGraphSolution {
   }
 
  private:
+  struct Empty {};
+
+  using PredecessorStorage = std::conditional_t<kPredecessors, PredecessorMatrix, Empty>;
+  using IndexNodeStorage   = std::conditional_t<kPredecessors, std::vector<NodeType>, Empty>;
+
   NodeMap    nodes;
   MatrixType edges;
 
+  [[no_unique_address]] PredecessorStorage predecessors;
+  [[no_unique_address]] IndexNodeStorage   index_nodes;
+
   friend class NeighborGraph<NodeType, EdgeType>;
 
   NeighborGraphSolution(const NeighborGraphSolution&) = default;
   NeighborGraphSolution&
   operator=(const NeighborGraphSolution&) = default;
+
+  ///
+  /// Size the predecessor matrix like the edges and invert the node map.
+  ///
+  void
+  InitPredecessors() requires kPredecessors {
+    predecessors = PredecessorMatrix(edges.Rows(), edges.Cols(), kNone);
+
+    index_nodes.resize(nodes.size());
+    for (const auto& [node, index]: nodes)
+      index_nodes[index] = node;
+  }
+
+  ///
+  /// Walk the predecessors of `row` back from `to` until `fr`, or until a
+  /// node without a predecessor.
+  ///
+  ShortestPath<NodeType, EdgeType>
+  ImplPath(std::size_t row, IndexType fr, IndexType to) const
+    requires kPredecessors {
+    ShortestPath<NodeType, EdgeType> path{edges.At(row, to), {}};
+    if (fr == to)
+      path.distance = EdgeType(0);
+    else if (path.distance == edges.DefaultValue())
+      return path;
+
+    auto prev = [&](IndexType index) {
+      return index == fr ? kNone : predecessors.At(row, index);
+    };
+
+    std::size_t hops = 1;
+    for (IndexType index = to; prev(index) != kNone; index = prev(index))
+      ++hops;
+
+    path.nodes.resize(hops);
+    IndexType index = to;
+    for (std::size_t n = hops; n-- > 0; index = prev(index))
+      path.nodes[n] = index_nodes[index];
+
+    return path;
+  }
 };
 
 ///
@@ -139,12 +277,21 @@ class NeighborGraphSolution {
 /// opposed to the `NeighborGraphSolution` which stores it in matrix
 /// form.
 ///
+/// Every node is interned into a dense `IndexType` id the first time it is
+/// seen, and edges are stored against those ids.  `NodeType` is only hashed
+/// when crossing the API boundary (`Index`, `Neighbors`, `AddEdge`), never
+/// while walking the graph by index.
+///
 template <typename NodeType_, typename EdgeType_>
 class NeighborGraph {
  public:
-  using NodeType = NodeType_;
-  using EdgeType = EdgeType_;
-  using NodeMap  = std::unordered_map<NodeType, std::size_t>;
+  using NodeType      = NodeType_;
+  using EdgeType      = EdgeType_;
+  using IndexType     = std::uint32_t;
+  using NodeMap       = std::unordered_map<NodeType, std::size_t>;
+  using Edge          = NodeEdge<NodeType, EdgeType>;
+  using IndexEdgeList = std::span<const IndexEdge<IndexType, EdgeType>>;
+  using EdgeList      = NodeEdgeRange<NodeType, IndexEdgeList>;
 
   ///
   /// @struct Spec
@@ -156,18 +303,6 @@ class NeighborGraph {
     EdgeType sentinal = std::numeric_limits<EdgeType>::max();
   };
 
-  ///
-  /// @struct Edge
-  ///
-  /// Structure for storing the edge.
-  ///
-  struct Edge {
-    NodeType node;
-    EdgeType edge;
-  };
-
-  using EdgeList = std::vector<Edge>;
-
   ///
   /// Basic constructor.
   ///
@@ -185,26 +320,18 @@ class NeighborGraph {
   }
 
   ///
-  /// Build a node map.
+  /// Build a node map.  The mapped values are the dense node indices.
   ///
   NodeMap
   BuildNodeMap() const {
-    NodeMap node_map;
-    for (const auto& node: Nodes())
-      node_map[node] = node_map.size();
-
     return node_map;
   }
 
   ///
-  /// Return a list of nodes.
+  /// Return a list of nodes, ordered by their index.
   ///
-  std::vector<NodeType>
+  const std::vector<NodeType>&
   Nodes() const {
-    std::vector<NodeType> nodes;
-    for (const auto& edge: edges)
-      nodes.push_back(edge.first);
-
     return nodes;
   }
 
@@ -213,7 +340,28 @@ class NeighborGraph {
   ///
   std::size_t
   NodeCount() const {
-    return edges.size();
+    return nodes.size();
+  }
+
+  ///
+  /// @param node Node to look up.
+  ///
+  /// Return the dense index of a node.
+  ///
+  IndexType
+  Index(const NodeType& node) const {
+    return node_map.at(node);
+  }
+
+  ///
+  /// @param index Dense index to look up.
+  ///
+  /// Return the node stored at a dense index.
+  ///
+  const NodeType&
+  Node(IndexType index) const {
+    assert(index < nodes.size());
+    return nodes[index];
   }
 
   ///
@@ -222,7 +370,7 @@ class NeighborGraph {
   ///
   void
   AddNode(NodeType node) {
-    edges[node] = {};
+    edges[Intern(node)].clear();
   }
 
   ///
@@ -235,25 +383,107 @@ class NeighborGraph {
   ///
   void
   AddEdge(NodeType node_fr, NodeType node_to, EdgeType edge) {
-    edges[node_fr].push_back({node_to, edge});
+    const IndexType idx_fr = Intern(node_fr);
+    const IndexType idx_to = Intern(node_to);
+
+    AddIndexEdge(idx_fr, idx_to, edge);
+  }
+
+  ///
+  /// @param node Node to intern.
+  ///
+  /// Return the dense index of a node, adding it with no edges if it did not
+  /// exist.
+  ///
+  IndexType
+  Intern(const NodeType& node) {
+    auto [iter, inserted] = node_map.try_emplace(node, nodes.size());
+    if (inserted) {
+      assert(nodes.size() < std::numeric_limits<IndexType>::max());
+      nodes.push_back(node);
+      edges.emplace_back();
+    }
+
+    return iter->second;
+  }
+
+  ///
+  /// @param idx_fr Edge source index.
+  /// @param idx_to Edge destination index.
+  /// @param edge   Edge weight from source -> destination.
+  ///
+  /// Add a new edge between two already interned nodes.
+  ///
+  void
+  AddIndexEdge(IndexType idx_fr, IndexType idx_to, EdgeType edge) {
+    assert(idx_fr < edges.size());
+    assert(idx_to < edges.size());
+
+    edges[idx_fr].push_back({idx_to, edge});
     if (!spec.directed) {
-      edges[node_to].push_back({node_fr, edge});
+      edges[idx_to].push_back({idx_fr, edge});
     }
   }
 
+  ///
+  /// @param node_count Number of nodes to reserve space for.
+  ///
+  /// Pre-allocate the node tables ahead of a bulk insert.
+  ///
+  void
+  Reserve(std::size_t node_count) {
+    nodes.reserve(node_count);
+    node_map.reserve(node_count);
+    edges.reserve(node_count);
+  }
+
+  ///
+  /// @param index      Dense index of the node.
+  /// @param edge_count Number of out-edges to reserve space for.
+  ///
+  /// Pre-allocate the adjacency of a single node ahead of a bulk insert.
+  ///
+  void
+  ReserveEdges(IndexType index, std::size_t edge_count) {
+    assert(index < edges.size());
+    edges[index].reserve(edge_count);
+  }
+
+  ///
+  /// Return true if edges are only added in the given direction.
+  ///
+  bool
+  Directed() const {
+    return spec.directed;
+  }
+
   ///
   /// @param node Node to get edges for.
   ///
-  /// Fetch a constant reference to the edges for a provided node.
+  /// Fetch a view of the edges for a provided node.
+  ///
+  EdgeList
+  Neighbors(const NodeType& node) const {
+    return EdgeList(IndexNeighbors(Index(node)), nodes.data());
+  }
+
+  ///
+  /// @param index Dense index of the node to get edges for.
+  ///
+  /// Fetch a view of the edges for a provided node index.  No hashing is
+  /// performed.
   ///
-  const EdgeList&
-  Neighbors(NodeType node) const {
-    return edges.at(node);
+  IndexEdgeList
+  IndexNeighbors(IndexType index) const {
+    assert(index < edges.size());
+    return edges[index];
   }
 
  private:
   Spec spec;
-  std::unordered_map<NodeType, EdgeList> edges;
+  std::vector<NodeType> nodes;
+  NodeMap node_map;
+  std::vector<std::vector<IndexEdge<IndexType, EdgeType>>> edges;
 };
 } // ns search
 
@@ -118,6 +118,52 @@ class DenseMatrix {
     return cols;
   }
 
+  ///
+  /// @param row Row index to fetch.
+  ///
+  /// Return a pointer to the first element of a row, the row is contiguous.
+  /// Only available for row major matrices.
+  ///
+  Type*
+  Row(std::size_t row) requires (order == Order::ROW_MAJOR) {
+    assert(row < rows);
+    return data.data() + row * cols;
+  }
+
+  ///
+  /// @param row Row index to fetch.
+  ///
+  /// Return a const pointer to the first element of a row.
+  ///
+  const Type*
+  Row(std::size_t row) const requires (order == Order::ROW_MAJOR) {
+    assert(row < rows);
+    return data.data() + row * cols;
+  }
+
+  ///
+  /// @param col Col index to fetch.
+  ///
+  /// Return a pointer to the first element of a col, the col is contiguous.
+  /// Only available for col major matrices.
+  ///
+  Type*
+  Col(std::size_t col) requires (order == Order::COL_MAJOR) {
+    assert(col < cols);
+    return data.data() + col * rows;
+  }
+
+  ///
+  /// @param col Col index to fetch.
+  ///
+  /// Return a const pointer to the first element of a col.
+  ///
+  const Type*
+  Col(std::size_t col) const requires (order == Order::COL_MAJOR) {
+    assert(col < cols);
+    return data.data() + col * rows;
+  }
+
   ///
   /// @tparam NewMat  New matrix storage type.
   ///
@@ -0,0 +1,117 @@
+#ifndef SEARCH_MATRIX_FIXED_POINT_HH_
+#define SEARCH_MATRIX_FIXED_POINT_HH_
+
+#include <cassert>
+#include <cmath>
+#include <concepts>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace search {
+///
+/// @class FixedPointError
+///
+/// Thrown when a distance can not be stored as unsigned fixed point.
+///
+class FixedPointError : public std::runtime_error {
+ public:
+  explicit FixedPointError(const std::string& what)
+    : std::runtime_error("FixedPointError: " + what) {}
+};
+
+///
+/// @class  FixedPoint
+/// @tparam Type_  Unsigned storage type, such as `uint16_t`.
+///
+/// Non-negative distances stored as `round(distance * scale)` in a narrow
+/// unsigned integer, to shrink all pairs tables: a `uint16_t` matrix is a
+/// quarter of a `double` one and fills twice the SIMD lanes of a `float`
+/// one.  The maximum value is the sentinal.  Distances which do not fit
+/// saturate into it, and so does every sum through `MinPlus::Add`, so an
+/// overflow reads as unreached and never wraps into a valid distance.
+///
+template <std::unsigned_integral Type_>
+class FixedPoint {
+ public:
+  using Type = Type_;
+
+  /// Stored for unreached pairs and for anything too far to represent.
+  static constexpr Type kSentinal = std::numeric_limits<Type>::max();
+
+  ///
+  /// @param scale Stored units per unit of distance, the resolution is
+  ///              `1 / scale` and the largest distance `(kSentinal - 1) /
+  ///              scale`.
+  ///
+  explicit FixedPoint(double scale = 1.0)
+    : scale(scale)
+  {
+    assert(scale > 0);
+  }
+
+  ///
+  /// Return the scale.
+  ///
+  double
+  Scale() const {
+    return scale;
+  }
+
+  ///
+  /// Return `value` in fixed point, or `kSentinal` if it is too large.
+  /// Throws `FixedPointError` for a negative value.
+  ///
+  template <typename EdgeType>
+  Type
+  Encode(EdgeType value) const {
+    if constexpr (std::is_signed_v<EdgeType>)
+      if (value < EdgeType(0))
+        throw FixedPointError("negative distance " + std::to_string(value));
+
+    const double scaled = std::round(double(value) * scale);
+    if (!(scaled < double(kSentinal)))
+      return kSentinal;
+
+    return Type(scaled);
+  }
+
+  ///
+  /// Return the distance stored as `value`, with `kSentinal` turned into
+  /// the largest `EdgeType` like the default value of a graph.
+  ///
+  template <typename EdgeType = double>
+  EdgeType
+  Decode(Type value) const {
+    if (value == kSentinal)
+      return std::numeric_limits<EdgeType>::max();
+
+    return EdgeType(double(value) / scale);
+  }
+
+ private:
+  double scale;
+};
+
+///
+/// @tparam StoreType  Element type of the solution matrix.
+/// @tparam EdgeType   Edge type of the graph, inferred.
+///
+/// Convert a graph distance to the element type a solver stores it as.  An
+/// unsigned storage type other than the graph's goes through `FixedPoint`
+/// with `scale`, any other type is converted as is.
+///
+template <typename StoreType, typename EdgeType>
+StoreType
+StoreDistance(EdgeType value, double scale) {
+  if constexpr (std::is_same_v<StoreType, EdgeType>)
+    return value;
+  else if constexpr (std::unsigned_integral<StoreType>)
+    return FixedPoint<StoreType>(scale).Encode(value);
+  else
+    return StoreType(value);
+}
+} // ns search
+
+#endif // SEARCH_MATRIX_FIXED_POINT_HH_
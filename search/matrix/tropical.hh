@@ -0,0 +1,553 @@
+#ifndef SEARCH_MATRIX_TROPICAL_HH_
+#define SEARCH_MATRIX_TROPICAL_HH_
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "search/matrix/dense.hh"
+#include "search/parallel/common.hh"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define SEARCH_MATRIX_TROPICAL_X86 1
+#include <immintrin.h>
+#endif
+
+namespace search {
+///
+/// @enum SimdLevel
+/// Instruction set a vectorized kernel runs with.
+///
+enum class SimdLevel {
+  /// Portable loop, vectorized by the compiler for the baseline target.
+  SCALAR = 1,
+  AVX2   = 2,
+  AVX512 = 3,
+};
+
+///
+/// @enum Semiring
+/// Which tropical semiring a kernel works in.
+///
+enum class Semiring {
+  /// (min, +), shortest paths.  The sentinal stands for +infinity.
+  MIN_PLUS = 1,
+  /// (max, +), longest or most reliable paths.  The sentinal stands for
+  /// -infinity.
+  MAX_PLUS = 2,
+};
+
+///
+/// @class  BasicTropical
+/// @tparam semiring_  See `Semiring`.
+///
+/// Kernels of a tropical semiring on raw rows, and the matrix product built
+/// on them.  A designated sentinal stands for the infinity nothing reaches:
+/// it never takes part in a sum and every value beats it.  The selection is
+/// done with lane masks rather than branches.
+///
+/// `float`, `double`, `int32_t` and `uint32_t` have AVX2 and AVX-512
+/// versions picked at runtime, `uint16_t` has an AVX2 version, every other
+/// type uses the portable loop.
+///
+template <Semiring semiring_>
+class BasicTropical {
+ public:
+  static constexpr Semiring semiring = semiring_;
+
+  ///
+  /// @struct Spec
+  ///
+  /// Specification for a matrix product.
+  ///
+  struct Spec {
+    /// Side of the square tiles of the right hand matrix kept in cache
+    /// while every row of the left hand one passes over them.
+    std::size_t block   = 256;
+    /// Number of threads, 0 means "all of them".  Rows of the result are
+    /// split between them.
+    std::size_t threads = 1;
+  };
+
+  ///
+  /// Return the widest instruction set this CPU supports, detected once.
+  ///
+  static SimdLevel
+  Supported() {
+    static const SimdLevel level = Detect();
+    return level;
+  }
+
+  ///
+  /// @tparam Type      Element type, inferred.
+  /// @param  row       Row to update, `count` elements.
+  /// @param  pivot     Row added to `scalar`, `count` elements.  It may be
+  ///                   `row` itself.
+  /// @param  scalar    Value added to every element of `pivot`.
+  /// @param  sentinal  Value standing for infinity.
+  /// @param  count     Number of elements.
+  ///
+  /// Replace `row[j]` by `pivot[j] + scalar` wherever that is better
+  /// (smaller for min-plus, larger for max-plus), the inner step of Floyd
+  /// Warshall and of a matrix product.  Sums follow `Add`.  Returns true if
+  /// any element changed.
+  ///
+  template <typename Type>
+  static bool
+  Row(Type* row, const Type* pivot, Type scalar, Type sentinal, std::size_t count) {
+    return Row(row, pivot, scalar, sentinal, count, Supported());
+  }
+
+  ///
+  /// @param level Instruction set to use, at most `Supported()`.
+  ///
+  /// Same as above, with an explicit instruction set.
+  ///
+  template <typename Type>
+  static bool
+  Row(Type* row, const Type* pivot, Type scalar, Type sentinal, std::size_t count,
+      SimdLevel level) {
+    if (scalar == sentinal)
+      return false;
+
+#ifdef SEARCH_MATRIX_TROPICAL_X86
+    if constexpr (std::is_same_v<Type, float>
+               || std::is_same_v<Type, double>
+               || std::is_same_v<Type, std::uint16_t>
+               || std::is_same_v<Type, std::int32_t>
+               || std::is_same_v<Type, std::uint32_t>) {
+      switch (level) {
+        case SimdLevel::AVX512:
+          // 16 bit lanes need AVX-512BW, AVX2 covers them instead.
+          if constexpr (std::is_same_v<Type, std::uint16_t>)
+            return RowAvx2(row, pivot, scalar, sentinal, count);
+          else
+            return RowAvx512(row, pivot, scalar, sentinal, count);
+        case SimdLevel::AVX2:
+          return RowAvx2(row, pivot, scalar, sentinal, count);
+        case SimdLevel::SCALAR:
+          break;
+      }
+    }
+#endif
+    (void) level;
+
+    return RowScalar(row, pivot, scalar, sentinal, 0, count);
+  }
+
+  ///
+  /// @tparam Type  Element type, inferred.
+  /// @param  lhs   Left hand `N x M` matrix.
+  /// @param  rhs   Right hand `M x P` matrix, with the same sentinal.
+  /// @param  spec  See `Spec`.
+  ///
+  /// Return the `N x P` product, `out(i, j)` is the best over `k` of
+  /// `lhs(i, k) + rhs(k, j)`, or the sentinal.
+  ///
+  template <typename Type>
+  static DenseMatrix<Type>
+  Multiply(const DenseMatrix<Type>& lhs, const DenseMatrix<Type>& rhs, Spec spec = {}) {
+    DenseMatrix<Type> out(lhs.Rows(), rhs.Cols(), lhs.DefaultValue());
+    MultiplyInto(lhs, rhs, out, spec);
+    return out;
+  }
+
+  ///
+  /// @tparam Type  Element type, inferred.
+  /// @param  lhs   Left hand `N x M` matrix.
+  /// @param  rhs   Right hand `M x P` matrix, with the same sentinal.
+  /// @param  out   `N x P` matrix to fold the product into, it must not be
+  ///               `lhs` or `rhs`.
+  /// @param  spec  See `Spec`.
+  ///
+  /// Replace every `out(i, j)` by the product entry where that is better.
+  /// Returns true if anything changed.
+  ///
+  template <typename Type>
+  static bool
+  MultiplyInto(const DenseMatrix<Type>& lhs, const DenseMatrix<Type>& rhs,
+               DenseMatrix<Type>& out, Spec spec = {}) {
+    assert(lhs.Cols() == rhs.Rows());
+    assert(out.Rows() == lhs.Rows() && out.Cols() == rhs.Cols());
+    assert(lhs.DefaultValue() == rhs.DefaultValue());
+    assert(&out != &lhs && &out != &rhs);
+
+    const Type        sentinal = lhs.DefaultValue();
+    const std::size_t block    = spec.block ? spec.block : std::max<std::size_t>(1, rhs.Cols());
+    const std::size_t inner    = lhs.Cols();
+    const std::size_t cols     = rhs.Cols();
+
+    std::vector<char> changed(ThreadCount(spec.threads), false);
+
+    ParallelFor(spec.threads, 0, lhs.Rows(),
+        [&](std::size_t thread, std::size_t lo, std::size_t hi) {
+          bool local = false;
+
+          // A `block x block` tile of `rhs` is reused by every row.
+          for (std::size_t k0 = 0; k0 < inner; k0 += block) {
+            const std::size_t k1 = std::min(inner, k0 + block);
+
+            for (std::size_t j0 = 0; j0 < cols; j0 += block) {
+              const std::size_t j1 = std::min(cols, j0 + block);
+
+              for (std::size_t i = lo; i < hi; ++i) {
+                const Type* row_lhs = lhs.Row(i);
+                Type*       row_out = out.Row(i);
+
+                for (std::size_t k = k0; k < k1; ++k)
+                  local |= Row(row_out + j0, rhs.Row(k) + j0, row_lhs[k], sentinal, j1 - j0);
+              }
+            }
+          }
+
+          changed[thread] = local;
+        });
+
+    return std::find(changed.begin(), changed.end(), true) != changed.end();
+  }
+
+  ///
+  /// @tparam Type      Element type, inferred.
+  /// @param  matrix    Square matrix.
+  /// @param  exponent  Number of factors.
+  /// @param  spec      See `Spec`.
+  ///
+  /// Return `matrix` multiplied by itself `exponent` times, by repeated
+  /// squaring.  For an adjacency matrix entry `(i, j)` is the best path of
+  /// exactly `exponent` edges, or of at most `exponent` if the diagonal is
+  /// zero.  The zeroth power is the identity, zero on the diagonal.
+  ///
+  template <typename Type>
+  static DenseMatrix<Type>
+  Power(const DenseMatrix<Type>& matrix, std::size_t exponent, Spec spec = {}) {
+    assert(matrix.Rows() == matrix.Cols());
+    const std::size_t count = matrix.Rows();
+
+    DenseMatrix<Type> result(count, count, matrix.DefaultValue());
+    for (std::size_t idx = 0; idx < count; ++idx)
+      result.At(idx, idx) = Type(0);
+
+    DenseMatrix<Type> base = Copy(matrix);
+    for (; exponent; exponent >>= 1) {
+      if (exponent & 1)
+        result = Multiply(result, base, spec);
+      if (exponent > 1)
+        base = Multiply(base, base, spec);
+    }
+
+    return result;
+  }
+
+  ///
+  /// Return `a + b`.  Unsigned integers saturate at their maximum, so
+  /// with the maximum as sentinal a sum which overflows reads as unreached
+  /// instead of wrapping around to a short distance.  Signed integers wrap
+  /// instead of overflowing, so a sum may be formed before the sentinal is
+  /// masked out.
+  ///
+  template <typename Type>
+  static Type
+  Add(Type a, Type b) {
+    if constexpr (std::is_integral_v<Type> && std::is_unsigned_v<Type>) {
+      const Type sum = Type(a + b);
+      return sum < a ? std::numeric_limits<Type>::max() : sum;
+    } else if constexpr (std::is_integral_v<Type>) {
+      using Unsigned = std::make_unsigned_t<Type>;
+      return Type(Unsigned(a) + Unsigned(b));
+    } else {
+      return a + b;
+    }
+  }
+
+  ///
+  /// Return true if `a` is better than `b` in this semiring.
+  ///
+  template <typename Type>
+  static bool
+  Better(Type a, Type b) {
+    if constexpr (semiring == Semiring::MIN_PLUS)
+      return a < b;
+    else
+      return b < a;
+  }
+
+  ///
+  /// Return an element by element copy of `matrix`.
+  ///
+  template <typename Type>
+  static DenseMatrix<Type>
+  Copy(const DenseMatrix<Type>& matrix) {
+    DenseMatrix<Type> copy(matrix.Rows(), matrix.Cols(), matrix.DefaultValue());
+    for (std::size_t row = 0; row < matrix.Rows(); ++row)
+      std::copy(matrix.Row(row), matrix.Row(row) + matrix.Cols(), copy.Row(row));
+    return copy;
+  }
+
+ private:
+  static constexpr bool kMin = (semiring == Semiring::MIN_PLUS);
+
+  static SimdLevel
+  Detect() {
+#ifdef SEARCH_MATRIX_TROPICAL_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+      return SimdLevel::AVX512;
+    if (__builtin_cpu_supports("avx2"))
+      return SimdLevel::AVX2;
+#endif
+    return SimdLevel::SCALAR;
+  }
+
+  ///
+  /// Portable kernel over `[begin, end)`, also the tail of the vector ones.
+  ///
+  template <typename Type>
+  static bool
+  RowScalar(Type* row, const Type* pivot, Type scalar, Type sentinal,
+            std::size_t begin, std::size_t end) {
+    bool changed = false;
+    for (std::size_t j = begin; j < end; ++j) {
+      const Type a    = row[j];
+      const Type b    = pivot[j];
+      const Type sum  = Add(b, scalar);
+      const bool take = (b != sentinal) & ((a == sentinal) | Better(sum, a));
+      row[j]   = take ? sum : a;
+      changed |= take;
+    }
+    return changed;
+  }
+
+#ifdef SEARCH_MATRIX_TROPICAL_X86
+  __attribute__((target("avx2")))
+  static bool
+  RowAvx2(float* row, const float* pivot, float scalar, float sentinal, std::size_t count) {
+    const __m256 s = _mm256_set1_ps(sentinal);
+    const __m256 c = _mm256_set1_ps(scalar);
+    __m256 any = _mm256_setzero_ps();
+
+    std::size_t j = 0;
+    for (; j + 8 <= count; j += 8) {
+      const __m256 a      = _mm256_loadu_ps(row + j);
+      const __m256 b      = _mm256_loadu_ps(pivot + j);
+      const __m256 sum    = _mm256_add_ps(b, c);
+      const __m256 better = kMin ? _mm256_cmp_ps(sum, a, _CMP_LT_OQ)
+                                 : _mm256_cmp_ps(a, sum, _CMP_LT_OQ);
+      const __m256 take   = _mm256_and_ps(
+          _mm256_cmp_ps(b, s, _CMP_NEQ_UQ),
+          _mm256_or_ps(_mm256_cmp_ps(a, s, _CMP_EQ_OQ), better)
+      );
+      _mm256_storeu_ps(row + j, _mm256_blendv_ps(a, sum, take));
+      any = _mm256_or_ps(any, take);
+    }
+
+    const bool changed = !_mm256_testz_ps(any, any);
+    return RowScalar(row, pivot, scalar, sentinal, j, count) | changed;
+  }
+
+  __attribute__((target("avx2")))
+  static bool
+  RowAvx2(double* row, const double* pivot, double scalar, double sentinal, std::size_t count) {
+    const __m256d s = _mm256_set1_pd(sentinal);
+    const __m256d c = _mm256_set1_pd(scalar);
+    __m256d any = _mm256_setzero_pd();
+
+    std::size_t j = 0;
+    for (; j + 4 <= count; j += 4) {
+      const __m256d a      = _mm256_loadu_pd(row + j);
+      const __m256d b      = _mm256_loadu_pd(pivot + j);
+      const __m256d sum    = _mm256_add_pd(b, c);
+      const __m256d better = kMin ? _mm256_cmp_pd(sum, a, _CMP_LT_OQ)
+                                  : _mm256_cmp_pd(a, sum, _CMP_LT_OQ);
+      const __m256d take   = _mm256_and_pd(
+          _mm256_cmp_pd(b, s, _CMP_NEQ_UQ),
+          _mm256_or_pd(_mm256_cmp_pd(a, s, _CMP_EQ_OQ), better)
+      );
+      _mm256_storeu_pd(row + j, _mm256_blendv_pd(a, sum, take));
+      any = _mm256_or_pd(any, take);
+    }
+
+    const bool changed = !_mm256_testz_pd(any, any);
+    return RowScalar(row, pivot, scalar, sentinal, j, count) | changed;
+  }
+
+  ///
+  /// Saturating adds, the unsigned order is turned into the signed one by
+  /// flipping the top bit.
+  ///
+  __attribute__((target("avx2")))
+  static bool
+  RowAvx2(std::uint16_t* row, const std::uint16_t* pivot, std::uint16_t scalar,
+          std::uint16_t sentinal, std::size_t count) {
+    const __m256i s    = _mm256_set1_epi16(std::int16_t(sentinal));
+    const __m256i c    = _mm256_set1_epi16(std::int16_t(scalar));
+    const __m256i flip = _mm256_set1_epi16(std::int16_t(0x8000u));
+    __m256i any = _mm256_setzero_si256();
+
+    std::size_t j = 0;
+    for (; j + 16 <= count; j += 16) {
+      const __m256i a      = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + j));
+      const __m256i b      = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pivot + j));
+      const __m256i sum    = _mm256_adds_epu16(b, c);
+      const __m256i a_key  = _mm256_xor_si256(a, flip);
+      const __m256i s_key  = _mm256_xor_si256(sum, flip);
+      const __m256i better = kMin ? _mm256_cmpgt_epi16(a_key, s_key)
+                                  : _mm256_cmpgt_epi16(s_key, a_key);
+      const __m256i take   = _mm256_andnot_si256(
+          _mm256_cmpeq_epi16(b, s),
+          _mm256_or_si256(_mm256_cmpeq_epi16(a, s), better)
+      );
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(row + j),
+                          _mm256_blendv_epi8(a, sum, take));
+      any = _mm256_or_si256(any, take);
+    }
+
+    const bool changed = !_mm256_testz_si256(any, any);
+    return RowScalar(row, pivot, scalar, sentinal, j, count) | changed;
+  }
+
+  ///
+  /// Shared by `int32_t` and `uint32_t`, the unsigned order is turned into
+  /// the signed one by flipping the top bit.
+  ///
+  template <typename Type>
+  __attribute__((target("avx2")))
+  static bool
+  RowAvx2(Type* row, const Type* pivot, Type scalar, Type sentinal, std::size_t count)
+    requires std::is_same_v<Type, std::int32_t> || std::is_same_v<Type, std::uint32_t> {
+    const __m256i s    = _mm256_set1_epi32(std::int32_t(sentinal));
+    const __m256i c    = _mm256_set1_epi32(std::int32_t(scalar));
+    const __m256i flip = _mm256_set1_epi32(
+        std::is_signed_v<Type> ? 0 : std::int32_t(0x80000000u));
+    __m256i any = _mm256_setzero_si256();
+
+    std::size_t j = 0;
+    for (; j + 8 <= count; j += 8) {
+      const __m256i a      = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + j));
+      const __m256i b      = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pivot + j));
+      __m256i       sum    = _mm256_add_epi32(b, c);
+      if constexpr (std::is_unsigned_v<Type>) {
+        // Saturate, an unsigned sum overflowed if it is below an operand.
+        const __m256i over = _mm256_cmpgt_epi32(_mm256_xor_si256(b, flip),
+                                                _mm256_xor_si256(sum, flip));
+        sum = _mm256_or_si256(sum, over);
+      }
+      const __m256i a_key  = _mm256_xor_si256(a, flip);
+      const __m256i s_key  = _mm256_xor_si256(sum, flip);
+      const __m256i better = kMin ? _mm256_cmpgt_epi32(a_key, s_key)
+                                  : _mm256_cmpgt_epi32(s_key, a_key);
+      const __m256i take   = _mm256_andnot_si256(
+          _mm256_cmpeq_epi32(b, s),
+          _mm256_or_si256(_mm256_cmpeq_epi32(a, s), better)
+      );
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(row + j),
+                          _mm256_blendv_epi8(a, sum, take));
+      any = _mm256_or_si256(any, take);
+    }
+
+    const bool changed = !_mm256_testz_si256(any, any);
+    return RowScalar(row, pivot, scalar, sentinal, j, count) | changed;
+  }
+
+  __attribute__((target("avx512f")))
+  static bool
+  RowAvx512(float* row, const float* pivot, float scalar, float sentinal, std::size_t count) {
+    const __m512 s = _mm512_set1_ps(sentinal);
+    const __m512 c = _mm512_set1_ps(scalar);
+    __mmask16 any = 0;
+
+    std::size_t j = 0;
+    for (; j + 16 <= count; j += 16) {
+      const __m512 a   = _mm512_loadu_ps(row + j);
+      const __m512 b   = _mm512_loadu_ps(pivot + j);
+      const __m512 sum = _mm512_add_ps(b, c);
+      const __mmask16 better = kMin ? _mm512_cmp_ps_mask(sum, a, _CMP_LT_OQ)
+                                    : _mm512_cmp_ps_mask(a, sum, _CMP_LT_OQ);
+      const __mmask16 take = _mm512_cmp_ps_mask(b, s, _CMP_NEQ_UQ)
+                          & (_mm512_cmp_ps_mask(a, s, _CMP_EQ_OQ) | better);
+      _mm512_mask_storeu_ps(row + j, take, sum);
+      any |= take;
+    }
+
+    return RowScalar(row, pivot, scalar, sentinal, j, count) | (any != 0);
+  }
+
+  __attribute__((target("avx512f")))
+  static bool
+  RowAvx512(double* row, const double* pivot, double scalar, double sentinal, std::size_t count) {
+    const __m512d s = _mm512_set1_pd(sentinal);
+    const __m512d c = _mm512_set1_pd(scalar);
+    __mmask8 any = 0;
+
+    std::size_t j = 0;
+    for (; j + 8 <= count; j += 8) {
+      const __m512d a   = _mm512_loadu_pd(row + j);
+      const __m512d b   = _mm512_loadu_pd(pivot + j);
+      const __m512d sum = _mm512_add_pd(b, c);
+      const __mmask8 better = kMin ? _mm512_cmp_pd_mask(sum, a, _CMP_LT_OQ)
+                                   : _mm512_cmp_pd_mask(a, sum, _CMP_LT_OQ);
+      const __mmask8 take = _mm512_cmp_pd_mask(b, s, _CMP_NEQ_UQ)
+                         & (_mm512_cmp_pd_mask(a, s, _CMP_EQ_OQ) | better);
+      _mm512_mask_storeu_pd(row + j, take, sum);
+      any |= take;
+    }
+
+    return RowScalar(row, pivot, scalar, sentinal, j, count) | (any != 0);
+  }
+
+  template <typename Type>
+  __attribute__((target("avx512f")))
+  static bool
+  RowAvx512(Type* row, const Type* pivot, Type scalar, Type sentinal, std::size_t count)
+    requires std::is_same_v<Type, std::int32_t> || std::is_same_v<Type, std::uint32_t> {
+    const __m512i s = _mm512_set1_epi32(std::int32_t(sentinal));
+    const __m512i c = _mm512_set1_epi32(std::int32_t(scalar));
+    __mmask16 any = 0;
+
+    std::size_t j = 0;
+    for (; j + 16 <= count; j += 16) {
+      const __m512i a   = _mm512_loadu_si512(row + j);
+      const __m512i b   = _mm512_loadu_si512(pivot + j);
+      __m512i       sum = _mm512_add_epi32(b, c);
+      if constexpr (std::is_unsigned_v<Type>)
+        sum = _mm512_mask_mov_epi32(sum, _mm512_cmplt_epu32_mask(sum, b),
+                                    _mm512_set1_epi32(-1));
+      const __m512i lhs = kMin ? sum : a;
+      const __m512i rhs = kMin ? a : sum;
+
+      __mmask16 better;
+      if constexpr (std::is_signed_v<Type>)
+        better = _mm512_cmplt_epi32_mask(lhs, rhs);
+      else
+        better = _mm512_cmplt_epu32_mask(lhs, rhs);
+
+      const __mmask16 take = _mm512_cmpneq_epi32_mask(b, s)
+                          & (_mm512_cmpeq_epi32_mask(a, s) | better);
+      _mm512_mask_storeu_epi32(row + j, take, sum);
+      any |= take;
+    }
+
+    return RowScalar(row, pivot, scalar, sentinal, j, count) | (any != 0);
+  }
+#endif
+};
+
+///
+/// @class MinPlus
+///
+/// Kernels and products of the (min, +) semiring.
+///
+using MinPlus = BasicTropical<Semiring::MIN_PLUS>;
+
+///
+/// @class MaxPlus
+///
+/// Kernels and products of the (max, +) semiring.
+///
+using MaxPlus = BasicTropical<Semiring::MAX_PLUS>;
+} // ns search
+
+#endif // SEARCH_MATRIX_TROPICAL_HH_
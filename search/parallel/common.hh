@@ -0,0 +1,120 @@
+#ifndef SEARCH_PARALLEL_COMMON_HH_
+#define SEARCH_PARALLEL_COMMON_HH_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace search {
+///
+/// @param requested Requested number of threads, 0 means "all of them".
+///
+/// Resolve a user supplied thread count into the number of threads to run.
+///
+inline std::size_t
+ThreadCount(std::size_t requested) {
+  if (requested != 0)
+    return requested;
+
+  return std::max<std::size_t>(1, std::thread::hardware_concurrency());
+}
+
+///
+/// @param threads Number of threads to run, see `ThreadCount`.
+/// @param func    Callable invoked as `func(thread_index)`.
+///
+/// Run `func` once on each of `threads` threads and wait for all of them.
+/// The calling thread runs index 0, so a count of 1 never spawns.  The first
+/// exception thrown by any thread is rethrown after every thread has joined.
+///
+template <typename Func>
+void
+ParallelRun(std::size_t threads, Func&& func) {
+  threads = ThreadCount(threads);
+
+  std::vector<std::exception_ptr> errors(threads);
+  auto guarded = [&](std::size_t index) {
+    try {
+      func(index);
+    } catch (...) {
+      errors[index] = std::current_exception();
+    }
+  };
+
+  std::vector<std::thread> workers;
+  workers.reserve(threads - 1);
+  for (std::size_t index = 1; index < threads; ++index)
+    workers.emplace_back(guarded, index);
+
+  guarded(0);
+
+  for (auto& worker: workers)
+    worker.join();
+
+  for (const auto& error: errors)
+    if (error)
+      std::rethrow_exception(error);
+}
+
+///
+/// @param threads Number of threads to run, see `ThreadCount`.
+/// @param begin   First index of the range.
+/// @param end     One past the last index of the range.
+/// @param func    Callable invoked as `func(thread_index, lo, hi)`.
+///
+/// Split `[begin, end)` into one contiguous chunk per thread and run `func`
+/// on each chunk in parallel.
+///
+template <typename Func>
+void
+ParallelFor(std::size_t threads, std::size_t begin, std::size_t end,
+            Func&& func) {
+  threads = std::min(ThreadCount(threads), std::max<std::size_t>(1, end - begin));
+
+  ParallelRun(threads, [&](std::size_t index) {
+    const std::size_t count = end - begin;
+    const std::size_t lo = begin + count * index / threads;
+    const std::size_t hi = begin + count * (index + 1) / threads;
+    func(index, lo, hi);
+  });
+}
+
+///
+/// @param target Value to lower, shared between threads.
+/// @param value  Candidate value.
+///
+/// Atomically lower `target` to `value` if `value` is smaller, using a CAS
+/// loop so it also works for floating point types.  Returns true if this
+/// call lowered it.
+///
+template <typename Type>
+bool
+AtomicMin(Type& target, Type value) {
+  std::atomic_ref<Type> ref(target);
+  Type current = ref.load(std::memory_order_relaxed);
+
+  while (value < current) {
+    if (ref.compare_exchange_weak(current, value, std::memory_order_relaxed))
+      return true;
+  }
+
+  return false;
+}
+
+///
+/// @param source Value shared between threads.
+///
+/// Read a value which other threads may be lowering with `AtomicMin`.
+///
+template <typename Type>
+Type
+AtomicLoad(const Type& source) {
+  return std::atomic_ref<Type>(const_cast<Type&>(source))
+      .load(std::memory_order_relaxed);
+}
+} // ns search
+
+#endif // SEARCH_PARALLEL_COMMON_HH_
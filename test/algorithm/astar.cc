@@ -0,0 +1,175 @@
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "search/algorithm/astar.hh"
+#include "search/algorithm/djikstra.hh"
+#include "search/graph/compressed_neighbor_graph.hh"
+#include "search/graph/neighbor_graph.hh"
+
+using namespace search;
+
+using Graph = NeighborGraph<unsigned, float>;
+
+static constexpr unsigned kWidth = 24;
+
+///
+/// A `kWidth` square grid where every step costs at least 1, so the
+/// manhattan distance is admissible.
+///
+static Graph
+MakeGrid(unsigned seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<float> weight(1.0, 4.0);
+
+  Graph graph;
+  for (unsigned y = 0; y < kWidth; ++y) {
+    for (unsigned x = 0; x < kWidth; ++x) {
+      const unsigned node = y * kWidth + x;
+      if (x + 1 < kWidth)
+        graph.AddEdge(node, node + 1, weight(rng));
+      if (y + 1 < kWidth)
+        graph.AddEdge(node, node + kWidth, weight(rng));
+    }
+  }
+  return graph;
+}
+
+static float
+Manhattan(unsigned node, unsigned target) {
+  const int dx = int(node % kWidth) - int(target % kWidth);
+  const int dy = int(node / kWidth) - int(target / kWidth);
+  return float(std::abs(dx) + std::abs(dy));
+}
+
+template <typename Graph, typename Path>
+static float
+PathLength(const Graph& graph, const Path& path) {
+  float total = 0;
+  for (std::size_t n = 1; n < path.nodes.size(); ++n) {
+    bool found = false;
+    for (const auto& neigh: graph.Neighbors(path.nodes[n - 1])) {
+      if (neigh.node == path.nodes[n]) {
+        total += neigh.edge;
+        found = true;
+        break;
+      }
+    }
+    EXPECT_TRUE(found);
+  }
+  return total;
+}
+
+TEST(AStar, Simple) {
+  Graph graph;
+  graph.AddEdge(0, 1, 1.0);
+  graph.AddEdge(1, 2, 1.0);
+  graph.AddEdge(2, 3, 1.0);
+  graph.AddEdge(3, 4, 3.0);
+  graph.AddEdge(0, 3, 2.5);
+  graph.AddEdge(3, 4, 1);
+  graph.AddNode(5);
+
+  auto zero = [](unsigned, unsigned) { return 0.0f; };
+
+  auto path = AStar::Solve(graph, 0, 4, zero);
+  ASSERT_TRUE(path.Found());
+  ASSERT_FLOAT_EQ(path.distance, 3.5);
+  ASSERT_EQ(path.nodes, (std::vector<unsigned>{0, 3, 4}));
+
+  auto self = AStar::Solve(graph, 2, 2, zero);
+  ASSERT_FLOAT_EQ(self.distance, 0.0);
+  ASSERT_EQ(self.nodes, (std::vector<unsigned>{2}));
+
+  auto missing = AStar::Solve(graph, 0, 5, zero);
+  ASSERT_FALSE(missing.Found());
+  ASSERT_EQ(missing.distance, graph.DefaultValue());
+}
+
+TEST(AStar, Grid) {
+  auto graph = MakeGrid(3);
+  CompressedNeighborGraph<unsigned, float> compressed(graph);
+
+  std::mt19937 rng(5);
+  std::uniform_int_distribution<unsigned> node(0, kWidth * kWidth - 1);
+
+  for (std::size_t n = 0; n < 50; ++n) {
+    const unsigned source = node(rng);
+    const unsigned target = node(rng);
+    const float    expect = Djikstra::Query(graph, source, target);
+
+    auto path = AStar::Solve(graph, source, target, Manhattan);
+    ASSERT_FLOAT_EQ(path.distance, expect);
+    ASSERT_EQ(path.nodes.front(), source);
+    ASSERT_EQ(path.nodes.back(), target);
+    ASSERT_FLOAT_EQ(PathLength(graph, path), expect);
+
+    auto other = BasicAStar<LazyHeapPolicy>::Solve(
+        compressed, source, target, Manhattan);
+    ASSERT_FLOAT_EQ(other.distance, expect);
+  }
+}
+
+TEST(AStar, Inconsistent) {
+  auto graph = MakeGrid(11);
+
+  // Admissible but not consistent, nodes get expanded more than once.
+  auto patchy = [](unsigned node, unsigned target) {
+    return (node % 3) ? Manhattan(node, target) : 0.0f;
+  };
+
+  std::mt19937 rng(7);
+  std::uniform_int_distribution<unsigned> node(0, kWidth * kWidth - 1);
+
+  for (std::size_t n = 0; n < 50; ++n) {
+    const unsigned source = node(rng);
+    const unsigned target = node(rng);
+
+    auto path = AStar::Solve(graph, source, target, patchy);
+    ASSERT_FLOAT_EQ(path.distance, Djikstra::Query(graph, source, target));
+    ASSERT_FLOAT_EQ(PathLength(graph, path), path.distance);
+  }
+}
+
+TEST(AStar, Workspace) {
+  auto graph = MakeGrid(13);
+  AStar::Workspace<Graph> workspace(graph);
+
+  std::mt19937 rng(17);
+  std::uniform_int_distribution<unsigned> node(0, kWidth * kWidth - 1);
+
+  for (std::size_t n = 0; n < 50; ++n) {
+    const unsigned source = node(rng);
+    const unsigned target = node(rng);
+
+    auto path = AStar::Solve(graph, source, target, Manhattan, workspace);
+    ASSERT_FLOAT_EQ(path.distance, Djikstra::Query(graph, source, target));
+    ASSERT_EQ(path.nodes.front(), source);
+    ASSERT_EQ(path.nodes.back(), target);
+    ASSERT_FLOAT_EQ(PathLength(graph, path), path.distance);
+  }
+
+  // The potential is memoized, even when nodes are improved again.
+  std::vector<std::size_t> calls(graph.NodeCount(), 0);
+  for (std::size_t n = 0; n < 20; ++n) {
+    const unsigned target_index = graph.Index(node(rng));
+    auto path = AStar::SolveIndex(
+        graph,
+        graph.Index(node(rng)),
+        target_index,
+        [&](unsigned index) {
+          ++calls[index];
+          return (index % 3) ? Manhattan(graph.Node(index), graph.Node(target_index))
+                             : 0.0f;
+        },
+        workspace);
+    ASSERT_TRUE(path.Found());
+
+    for (auto& count: calls) {
+      ASSERT_LE(count, 1);
+      count = 0;
+    }
+  }
+}
@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 
+#include <random>
 #include <string>
+#include <vector>
 
 #include "search/algorithm/bellman_ford.hh"
 #include "search/matrix/dense.hh"
@@ -43,6 +45,84 @@ TEST(BellmanFord, NegativeCycle) {
   }
 }
 
+TEST(BellmanFord, NegativeCycleDirected) {
+  Graph graph({.directed = true});
+  graph.AddEdge(0, 1,  1.0);
+  graph.AddEdge(1, 2,  1.0);
+  graph.AddEdge(2, 3,  1.0);
+  graph.AddEdge(3, 1, -2.5);
+  graph.AddEdge(3, 4,  1.0);
+
+  for (auto method: {BellmanFordMethod::ROUNDS,
+                     BellmanFordMethod::QUEUE,
+                     BellmanFordMethod::EDGES}) {
+    ASSERT_THROW(
+        BellmanFord::Solve(graph, 0, {.method = method}),
+        BellmanFordNegativeWeight
+    );
+  }
+
+  // Not reachable from the start.
+  auto solution = BellmanFord::Solve(graph, 4);
+  ASSERT_FLOAT_EQ(solution.Distance(4), 0.0);
+  ASSERT_EQ(solution.Distance(0), graph.DefaultValue());
+}
+
+TEST(BellmanFord, Methods) {
+  using IntGraph = NeighborGraph<unsigned, int>;
+
+  std::mt19937 rng(29);
+  std::uniform_int_distribution<unsigned> node(0, 499);
+  std::uniform_int_distribution<int> weight(0, 20);
+  std::uniform_int_distribution<int> potential(-30, 30);
+
+  // Reduced costs `w + p(fr) - p(to)` are often negative, but every cycle
+  // keeps its non-negative weight.
+  std::vector<int> p(500);
+  for (auto& value: p)
+    value = potential(rng);
+
+  IntGraph graph({.directed = true});
+  for (std::size_t n = 0; n < 3000; ++n) {
+    const unsigned fr = node(rng);
+    const unsigned to = node(rng);
+    graph.AddEdge(fr, to, weight(rng) + p[fr] - p[to]);
+  }
+
+  const unsigned start = graph.Nodes().front();
+  auto rounds = BellmanFord::Solve(graph, start, {.method = BellmanFordMethod::ROUNDS});
+  auto queue  = BellmanFord::Solve<Record::PREDECESSORS>(
+      graph, start, {.method = BellmanFordMethod::QUEUE});
+
+  for (std::size_t threads: {1, 3, 0}) {
+    auto edges = BellmanFord::Solve<Record::PREDECESSORS>(
+        graph, start, {.method = BellmanFordMethod::EDGES, .threads = threads});
+
+    for (const auto& to: graph.Nodes()) {
+      ASSERT_EQ(rounds.Distance(to), edges.Distance(to));
+
+      const auto path = edges.Path(to);
+      ASSERT_EQ(path.Found(), edges.Distance(to) != graph.DefaultValue());
+      if (path.Found()) {
+        ASSERT_EQ(path.nodes.front(), start);
+        ASSERT_EQ(path.nodes.back(), to);
+      }
+    }
+  }
+
+  for (const auto& to: graph.Nodes()) {
+    ASSERT_EQ(rounds.Distance(to), queue.Distance(to));
+
+    const auto path = queue.Path(to);
+    if (!path.Found())
+      continue;
+
+    ASSERT_EQ(path.distance, queue.Distance(to));
+    ASSERT_EQ(path.nodes.front(), start);
+    ASSERT_EQ(path.nodes.back(), to);
+  }
+}
+
 #if 0
 TEST(BellmanFord, Multi) {
   Graph graph;
@@ -100,3 +180,24 @@ TEST(BellmanFord, MultiString) {
   ASSERT_FLOAT_EQ(solution.Distance("4", "1"), 3.0);
 }
 #endif
+
+TEST(BellmanFord, Predecessors) {
+  Graph graph({.directed = true});
+  graph.AddEdge(0, 1,  1.0);
+  graph.AddEdge(1, 2, -0.5);
+  graph.AddEdge(2, 3,  1.0);
+  graph.AddEdge(0, 3,  2.0);
+  graph.AddEdge(4, 0,  1.0);
+
+  for (auto method: {BellmanFordMethod::ROUNDS,
+                     BellmanFordMethod::QUEUE,
+                     BellmanFordMethod::EDGES}) {
+    auto solution = BellmanFord::Solve<Record::PREDECESSORS>(graph, 0, {.method = method});
+
+    auto path = solution.Path(3);
+    ASSERT_FLOAT_EQ(path.distance, 1.5);
+    ASSERT_EQ(path.nodes, (std::vector<unsigned>{0, 1, 2, 3}));
+
+    ASSERT_FALSE(solution.Path(4).Found());
+  }
+}
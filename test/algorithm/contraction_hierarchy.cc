@@ -0,0 +1,183 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+
+#include "search/algorithm/contraction_hierarchy.hh"
+#include "search/algorithm/djikstra.hh"
+#include "search/graph/neighbor_graph.hh"
+
+using namespace search;
+
+using Graph     = NeighborGraph<unsigned, float>;
+using Hierarchy = ContractionHierarchy<unsigned, float>;
+
+using IntGraph     = NeighborGraph<unsigned, std::uint32_t>;
+using IntHierarchy = ContractionHierarchy<unsigned, std::uint32_t>;
+
+static IntGraph
+MakeRandom(unsigned seed, std::size_t nodes, std::size_t edges) {
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<unsigned> node(0, nodes - 1);
+  std::uniform_int_distribution<std::uint32_t> weight(1, 100);
+
+  IntGraph graph({.directed = true});
+  for (unsigned n = 0; n < nodes; ++n)
+    graph.AddNode(n);
+  for (std::size_t n = 0; n < edges; ++n)
+    graph.AddEdge(node(rng), node(rng), weight(rng));
+  return graph;
+}
+
+template <typename Graph, typename Path>
+static typename Graph::EdgeType
+PathLength(const Graph& graph, const Path& path) {
+  typename Graph::EdgeType total = 0;
+  for (std::size_t n = 1; n < path.nodes.size(); ++n) {
+    bool found = false;
+    auto best  = graph.DefaultValue();
+    for (const auto& neigh: graph.Neighbors(path.nodes[n - 1])) {
+      if (neigh.node == path.nodes[n] && neigh.edge < best) {
+        best  = neigh.edge;
+        found = true;
+      }
+    }
+    EXPECT_TRUE(found);
+    total += best;
+  }
+  return total;
+}
+
+template <typename Graph, typename Hierarchy>
+static void
+ExpectMatchesDjikstra(const Graph& graph, const Hierarchy& hierarchy) {
+  typename Hierarchy::Workspace workspace(hierarchy);
+
+  for (const auto& source: graph.Nodes()) {
+    auto expect = Djikstra::Solve(graph, source);
+
+    for (const auto& target: graph.Nodes()) {
+      ASSERT_EQ(hierarchy.Distance(source, target, workspace),
+                expect.Distance(target));
+
+      auto path = hierarchy.Path(source, target, workspace);
+      ASSERT_EQ(path.distance, expect.Distance(target));
+      if (path.Found()) {
+        ASSERT_EQ(path.nodes.front(), source);
+        ASSERT_EQ(path.nodes.back(), target);
+        ASSERT_EQ(PathLength(graph, path), path.distance);
+      } else {
+        ASSERT_EQ(path.distance, graph.DefaultValue());
+      }
+    }
+  }
+}
+
+TEST(ContractionHierarchy, Simple) {
+  Graph graph;
+  graph.AddEdge(0, 1, 1.0);
+  graph.AddEdge(1, 2, 1.0);
+  graph.AddEdge(2, 3, 1.0);
+  graph.AddEdge(3, 4, 3.0);
+  graph.AddEdge(0, 3, 2.5);
+  graph.AddEdge(3, 4, 1);
+  graph.AddNode(5);
+
+  Hierarchy hierarchy(graph);
+
+  ASSERT_EQ(hierarchy.NodeCount(), 6);
+  ASSERT_FLOAT_EQ(hierarchy.Distance(0, 0), 0.0);
+  ASSERT_FLOAT_EQ(hierarchy.Distance(0, 2), 2.0);
+  ASSERT_FLOAT_EQ(hierarchy.Distance(0, 4), 3.5);
+  ASSERT_FLOAT_EQ(hierarchy.Distance(4, 1), 3.0);
+  ASSERT_EQ(hierarchy.Distance(0, 5), graph.DefaultValue());
+
+  auto path = hierarchy.Path(0, 4);
+  ASSERT_FLOAT_EQ(path.distance, 3.5);
+  ASSERT_EQ(path.nodes, (std::vector<unsigned>{0, 3, 4}));
+
+  ASSERT_FALSE(hierarchy.Path(5, 0).Found());
+}
+
+TEST(ContractionHierarchy, Directed) {
+  for (unsigned seed = 0; seed < 4; ++seed) {
+    auto graph = MakeRandom(seed, 60, 240);
+    IntHierarchy hierarchy(graph);
+    ExpectMatchesDjikstra(graph, hierarchy);
+  }
+}
+
+TEST(ContractionHierarchy, WitnessLimit) {
+  auto graph = MakeRandom(9, 60, 240);
+
+  IntHierarchy bounded(graph, {.witness_settles = 1});
+  IntHierarchy unbounded(graph, {.witness_settles = 0});
+
+  // Giving up on witnesses early only adds shortcuts, never wrong answers.
+  ASSERT_GE(bounded.ShortcutCount(), unbounded.ShortcutCount());
+  ExpectMatchesDjikstra(graph, bounded);
+  ExpectMatchesDjikstra(graph, unbounded);
+}
+
+TEST(ContractionHierarchy, Grid) {
+  constexpr unsigned kWidth = 16;
+  std::mt19937 rng(3);
+  std::uniform_real_distribution<float> weight(1.0, 4.0);
+
+  Graph graph;
+  for (unsigned y = 0; y < kWidth; ++y) {
+    for (unsigned x = 0; x < kWidth; ++x) {
+      const unsigned node = y * kWidth + x;
+      if (x + 1 < kWidth)
+        graph.AddEdge(node, node + 1, weight(rng));
+      if (y + 1 < kWidth)
+        graph.AddEdge(node, node + kWidth, weight(rng));
+    }
+  }
+
+  Hierarchy hierarchy(graph);
+  Hierarchy::Workspace workspace(hierarchy);
+
+  for (const auto& source: graph.Nodes()) {
+    auto expect = Djikstra::Solve(graph, source);
+    for (const auto& target: graph.Nodes()) {
+      auto path = hierarchy.Path(source, target, workspace);
+      ASSERT_FLOAT_EQ(path.distance, expect.Distance(target));
+      ASSERT_FLOAT_EQ(PathLength(graph, path), path.distance);
+    }
+  }
+}
+
+TEST(ContractionHierarchy, SaveLoad) {
+  const auto path = testing::TempDir() + "contraction_hierarchy.ch";
+  auto graph = MakeRandom(5, 50, 200);
+
+  IntHierarchy original(graph);
+  original.Save(path);
+
+  auto loaded = IntHierarchy::Load(path);
+  ASSERT_EQ(loaded.NodeCount(), original.NodeCount());
+  ASSERT_EQ(loaded.ShortcutCount(), original.ShortcutCount());
+  for (const auto& node: graph.Nodes())
+    ASSERT_EQ(loaded.Rank(node), original.Rank(node));
+
+  ExpectMatchesDjikstra(graph, loaded);
+
+  ASSERT_THROW(Hierarchy::Load(path), ContractionHierarchyError);
+  ASSERT_THROW(IntHierarchy::Load(path + ".missing"), ContractionHierarchyError);
+
+  {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << "not a hierarchy";
+  }
+  ASSERT_THROW(IntHierarchy::Load(path), ContractionHierarchyError);
+
+  // Renaming over a directory fails after the temporary is written.
+  const auto directory = testing::TempDir() + "contraction_hierarchy.dir";
+  std::filesystem::create_directories(directory);
+  ASSERT_THROW(original.Save(directory), ContractionHierarchyError);
+  ASSERT_FALSE(std::filesystem::exists(directory + ".tmp"));
+}
@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <string>
+
+#include "search/algorithm/delta_stepping.hh"
+#include "search/algorithm/djikstra.hh"
+#include "search/graph/compressed_neighbor_graph.hh"
+#include "search/graph/neighbor_graph.hh"
+
+using namespace search;
+
+using Graph = NeighborGraph<unsigned, float>;
+
+TEST(DeltaStepping, Single) {
+  Graph graph;
+  graph.AddEdge(0, 1, 1.0);
+  graph.AddEdge(1, 2, 1.0);
+  graph.AddEdge(2, 3, 1.0);
+  graph.AddEdge(3, 4, 3.0);
+  graph.AddEdge(0, 3, 2.5);
+  graph.AddEdge(3, 4, 1);
+
+  for (double delta: {0.0, 0.5, 1.0, 10.0}) {
+    auto solution = DeltaStepping::Solve(graph, 0, {.delta = delta, .threads = 2});
+
+    ASSERT_FLOAT_EQ(solution.Distance(0), 0.0);
+    ASSERT_FLOAT_EQ(solution.Distance(1), 1.0);
+    ASSERT_FLOAT_EQ(solution.Distance(2), 2.0);
+    ASSERT_FLOAT_EQ(solution.Distance(3), 2.5);
+    ASSERT_FLOAT_EQ(solution.Distance(4), 3.5);
+  }
+}
+
+TEST(DeltaStepping, String) {
+  NeighborGraph<std::string, float> graph({.directed = true});
+  graph.AddEdge("a", "b", 1.0);
+  graph.AddEdge("b", "c", 1.0);
+  graph.AddEdge("c", "a", 1.0);
+  graph.AddNode("d");
+
+  auto solution = DeltaStepping::Solve(graph, "b", {.threads = 3});
+
+  ASSERT_FLOAT_EQ(solution.Distance("c"), 1.0);
+  ASSERT_FLOAT_EQ(solution.Distance("a"), 2.0);
+  ASSERT_EQ(solution.Distance("d"), graph.DefaultValue());
+}
+
+TEST(DeltaStepping, MatchesDjikstra) {
+  std::mt19937 rng(3);
+  std::uniform_int_distribution<unsigned> node(0, 1999);
+  std::uniform_real_distribution<float> weight(0.0, 10.0);
+
+  Graph graph({.directed = true});
+  for (std::size_t n = 0; n < 10000; ++n)
+    graph.AddEdge(node(rng), node(rng), weight(rng));
+
+  CompressedNeighborGraph<unsigned, float> compressed(graph);
+  const auto start = graph.Nodes()[0];
+  auto expect = Djikstra::Solve(compressed, start);
+
+  for (std::size_t threads: {1, 4}) {
+    for (double delta: {0.0, 0.1, 3.0, 100.0}) {
+      auto actual = DeltaStepping::Solve(
+          compressed, start, {.delta = delta, .threads = threads});
+
+      for (const auto& to: graph.Nodes())
+        ASSERT_EQ(expect.Distance(to), actual.Distance(to));
+    }
+  }
+}
+
+TEST(DeltaStepping, Integer) {
+  std::mt19937 rng(5);
+  std::uniform_int_distribution<unsigned> node(0, 499);
+  std::uniform_int_distribution<std::uint32_t> weight(0, 50);
+
+  NeighborGraph<unsigned, std::uint32_t> graph;
+  for (std::size_t n = 0; n < 3000; ++n)
+    graph.AddEdge(node(rng), node(rng), weight(rng));
+
+  const auto start = graph.Nodes()[0];
+  auto expect = Djikstra::Solve(graph, start);
+  auto actual = DeltaStepping::Solve(graph, start, {.threads = 4});
+
+  for (const auto& to: graph.Nodes())
+    ASSERT_EQ(expect.Distance(to), actual.Distance(to));
+}
+
+TEST(DeltaStepping, LongPaths) {
+  // Distances run to millions of buckets of a tiny delta, which only a ring
+  // of `max_edge / delta` buckets keeps small.
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<float> weight(0.5, 1.5);
+
+  Graph graph({.directed = true});
+  for (unsigned n = 0; n + 1 < 4000; ++n) {
+    graph.AddEdge(n, n + 1, weight(rng));
+    if (n + 7 < 4000)
+      graph.AddEdge(n, n + 7, 7 * weight(rng));
+  }
+
+  auto expect = Djikstra::Solve(graph, 0);
+  for (std::size_t threads: {1, 3}) {
+    auto actual = DeltaStepping::Solve(
+        graph, 0, {.delta = 0.001, .threads = threads});
+
+    for (const auto& to: graph.Nodes())
+      ASSERT_EQ(expect.Distance(to), actual.Distance(to));
+  }
+}
+
+TEST(DeltaStepping, LargeWeights) {
+  // Float distances far beyond the precision of `dist / delta`, where a
+  // rounded bucket index must neither stall nor lose a node.
+  std::mt19937 rng(11);
+  std::uniform_int_distribution<unsigned> node(0, 7);
+  std::uniform_int_distribution<int> power(0, 1);
+
+  Graph graph({.directed = true});
+  for (unsigned n = 0; n < 8; ++n)
+    graph.AddEdge(n, (n + 1) % 8, float(1 << 25));
+  for (std::size_t n = 0; n < 16; ++n)
+    graph.AddEdge(node(rng), node(rng), float(1 << (24 + power(rng))));
+
+  auto expect = Djikstra::Solve(graph, 0);
+  for (double delta: {0.37, 1000.0, 3.0e6, 0.0}) {
+    auto actual = DeltaStepping::Solve(graph, 0, {.delta = delta});
+
+    for (const auto& to: graph.Nodes())
+      ASSERT_EQ(expect.Distance(to), actual.Distance(to));
+  }
+}
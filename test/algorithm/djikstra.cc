@@ -1,9 +1,13 @@
 #include <gtest/gtest.h>
 
+#include <cstdint>
+#include <random>
 #include <string>
 
 #include "search/algorithm/djikstra.hh"
+#include "search/graph/compressed_neighbor_graph.hh"
 #include "search/matrix/dense.hh"
+#include "search/matrix/fixed_point.hh"
 #include "search/matrix/sparse_map.hh"
 
 using namespace search;
@@ -82,3 +86,391 @@ TEST(Djikstra, MultiString) {
   ASSERT_FLOAT_EQ(solution.Distance("3", "1"), 2.0);
   ASSERT_FLOAT_EQ(solution.Distance("4", "1"), 3.0);
 }
+
+template <typename Solver>
+static void
+CheckAgainst(const Graph& graph) {
+  auto expect = Djikstra::Solve(graph);
+  auto actual = Solver::Solve(graph);
+
+  for (const auto& fr: graph.Nodes()) {
+    for (const auto& to: graph.Nodes()) {
+      ASSERT_FLOAT_EQ(expect.Distance(fr, to), actual.Distance(fr, to));
+    }
+  }
+}
+
+TEST(Djikstra, HeapPolicies) {
+  std::mt19937 rng(7);
+  std::uniform_int_distribution<unsigned> node(0, 199);
+  std::uniform_int_distribution<unsigned> weight(1, 100);
+
+  Graph graph;
+  for (std::size_t n = 0; n < 1000; ++n)
+    graph.AddEdge(node(rng), node(rng), weight(rng));
+
+  CheckAgainst<BasicDjikstra<LazyHeapPolicy>>(graph);
+  CheckAgainst<BasicDjikstra<DaryHeapPolicy<2>>>(graph);
+  CheckAgainst<BasicDjikstra<DaryHeapPolicy<8>>>(graph);
+
+  auto single = BasicDjikstra<LazyHeapPolicy>::Solve(graph, graph.Nodes()[0]);
+  auto expect = Djikstra::Solve(graph, graph.Nodes()[0]);
+  for (const auto& to: graph.Nodes())
+    ASSERT_FLOAT_EQ(single.Distance(to), expect.Distance(to));
+}
+
+TEST(Djikstra, IntegerHeapPolicies) {
+  using IntegerGraph = NeighborGraph<unsigned, std::uint32_t>;
+  static_assert(DefaultHeapPolicy::kRadix<std::uint32_t>);
+  static_assert(!DefaultHeapPolicy::kRadix<float>);
+
+  std::mt19937 rng(9);
+  std::uniform_int_distribution<unsigned> node(0, 299);
+  std::uniform_int_distribution<std::uint32_t> weight(0, 20);
+
+  IntegerGraph graph({.directed = true});
+  for (std::size_t n = 0; n < 2000; ++n)
+    graph.AddEdge(node(rng), node(rng), weight(rng));
+
+  using Reference = BasicDjikstra<DaryHeapPolicy<4>>;
+  using Bucket    = BasicDjikstra<BucketHeapPolicy<20>>;
+
+  auto expect = Reference::Solve(graph);
+  auto radix  = Djikstra::Solve(graph);
+  auto bucket = Bucket::Solve(graph);
+
+  for (const auto& fr: graph.Nodes()) {
+    for (const auto& to: graph.Nodes()) {
+      ASSERT_EQ(expect.Distance(fr, to), radix.Distance(fr, to));
+      ASSERT_EQ(expect.Distance(fr, to), bucket.Distance(fr, to));
+    }
+  }
+
+  // An edge heavier than the bound is reported, not silently misordered.
+  graph.AddEdge(0, 1, 21);
+  ASSERT_THROW(Bucket::Solve(graph), HeapError);
+}
+
+TEST(Djikstra, MultiThreaded) {
+  std::mt19937 rng(13);
+  std::uniform_int_distribution<unsigned> node(0, 299);
+  std::uniform_real_distribution<float> weight(0.0, 5.0);
+
+  Graph graph({.directed = true});
+  for (std::size_t n = 0; n < 2000; ++n)
+    graph.AddEdge(node(rng), node(rng), weight(rng));
+
+  auto expect = Djikstra::Solve(graph);
+
+  for (std::size_t threads: {0, 2, 7}) {
+    auto actual = Djikstra::Solve(graph, {.threads = threads});
+
+    for (const auto& fr: graph.Nodes()) {
+      for (const auto& to: graph.Nodes()) {
+        ASSERT_EQ(expect.Distance(fr, to), actual.Distance(fr, to));
+      }
+    }
+  }
+}
+
+TEST(Djikstra, MultiThreadedSparse) {
+  std::mt19937 rng(17);
+  std::uniform_int_distribution<unsigned> node(0, 149);
+  std::uniform_real_distribution<float> weight(0.0, 5.0);
+
+  Graph graph({.directed = true});
+  for (std::size_t n = 0; n < 800; ++n)
+    graph.AddEdge(node(rng), node(rng), weight(rng));
+
+  auto expect = Djikstra::Solve(graph);
+
+  // A sparse map shares its table between rows, stores are serialized.
+  auto sparse = Djikstra::Solve<
+      Record::PREDECESSORS,
+      Graph,
+      SparseMapMatrix<float>
+  >(graph, {.threads = 4});
+
+  for (const auto& fr: graph.Nodes()) {
+    for (const auto& to: graph.Nodes()) {
+      ASSERT_EQ(expect.Distance(fr, to), sparse.Distance(fr, to));
+
+      const auto path = sparse.Path(fr, to);
+      ASSERT_EQ(path.Found(), expect.Distance(fr, to) != graph.DefaultValue());
+    }
+  }
+}
+
+TEST(Djikstra, FixedPoint) {
+  std::mt19937 rng(59);
+  std::uniform_int_distribution<unsigned> node(0, 199);
+  std::uniform_real_distribution<float> weight(0.0, 5.0);
+
+  Graph graph({.directed = true});
+  for (std::size_t n = 0; n < 1000; ++n)
+    graph.AddEdge(node(rng), node(rng), weight(rng));
+
+  auto expect = Djikstra::Solve(graph);
+
+  // A fine scale saturates the longer distances, which read as unreached.
+  for (double scale: {100.0, 10000.0}) {
+    const FixedPoint<std::uint16_t> fixed(scale);
+
+    for (std::size_t threads: {1, 3}) {
+      auto actual = Djikstra::Solve<
+          Record::DISTANCES,
+          Graph,
+          DenseMatrix<std::uint16_t>
+      >(graph, {.threads = threads, .scale = scale});
+
+      for (const auto& fr: graph.Nodes()) {
+        for (const auto& to: graph.Nodes()) {
+          ASSERT_EQ(fixed.Encode(expect.Distance(fr, to)), actual.Distance(fr, to));
+          if (actual.Distance(fr, to) != fixed.kSentinal) {
+            ASSERT_NEAR(fixed.Decode<float>(actual.Distance(fr, to)),
+                        expect.Distance(fr, to), 0.5 / scale + 1e-4);
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(Djikstra, Query) {
+  Graph graph;
+  graph.AddEdge(0, 1, 1.0);
+  graph.AddEdge(1, 2, 1.0);
+  graph.AddEdge(2, 3, 1.0);
+  graph.AddEdge(3, 4, 3.0);
+  graph.AddEdge(0, 3, 2.5);
+  graph.AddEdge(3, 4, 1);
+  graph.AddNode(5);
+
+  ASSERT_FLOAT_EQ(Djikstra::Query(graph, 0, 0), 0.0);
+  ASSERT_FLOAT_EQ(Djikstra::Query(graph, 0, 2), 2.0);
+  ASSERT_FLOAT_EQ(Djikstra::Query(graph, 0, 4), 3.5);
+  ASSERT_FLOAT_EQ(Djikstra::Query(graph, 4, 1), 3.0);
+  ASSERT_EQ(Djikstra::Query(graph, 0, 5), graph.DefaultValue());
+
+  ASSERT_FLOAT_EQ(Djikstra::BidirectionalQuery(graph, graph, 0, 0), 0.0);
+  ASSERT_FLOAT_EQ(Djikstra::BidirectionalQuery(graph, graph, 0, 2), 2.0);
+  ASSERT_FLOAT_EQ(Djikstra::BidirectionalQuery(graph, graph, 0, 4), 3.5);
+  ASSERT_FLOAT_EQ(Djikstra::BidirectionalQuery(graph, graph, 4, 1), 3.0);
+  ASSERT_EQ(Djikstra::BidirectionalQuery(graph, graph, 0, 5),
+            graph.DefaultValue());
+}
+
+TEST(Djikstra, BidirectionalDirected) {
+  std::mt19937 rng(17);
+  std::uniform_int_distribution<unsigned> node(0, 399);
+  std::uniform_int_distribution<unsigned> weight(1, 64);
+
+  Graph graph({.directed = true});
+  for (std::size_t n = 0; n < 1600; ++n)
+    graph.AddEdge(node(rng), node(rng), weight(rng) / 8.0f);
+
+  CompressedNeighborGraph<unsigned, float> compressed(graph);
+  auto reverse = compressed.Reverse();
+
+  for (std::size_t n = 0; n < 20; ++n) {
+    const auto source = graph.Nodes()[node(rng) % graph.NodeCount()];
+    auto expect = Djikstra::Solve(compressed, source);
+
+    for (const auto& target: graph.Nodes()) {
+      ASSERT_EQ(expect.Distance(target),
+                Djikstra::Query(compressed, source, target));
+      ASSERT_EQ(expect.Distance(target),
+                Djikstra::BidirectionalQuery(compressed, reverse, source, target));
+    }
+  }
+}
+
+TEST(Djikstra, Workspace) {
+  std::mt19937 rng(23);
+  std::uniform_int_distribution<unsigned> node(0, 299);
+  std::uniform_int_distribution<unsigned> weight(1, 64);
+
+  Graph graph({.directed = true});
+  for (unsigned n = 0; n < 300; ++n)
+    graph.AddNode(n);
+  for (std::size_t n = 0; n < 1200; ++n)
+    graph.AddEdge(node(rng), node(rng), weight(rng) / 4.0f);
+
+  Djikstra::Workspace<Graph> workspace(graph);
+  Djikstra::Workspace<Graph> backward(graph);
+  CompressedNeighborGraph<unsigned, float> compressed(graph);
+  auto reverse = compressed.Reverse();
+  Djikstra::Workspace<decltype(compressed)> forward_compressed(compressed);
+  Djikstra::Workspace<decltype(compressed)> backward_compressed(compressed);
+
+  for (std::size_t n = 0; n < 40; ++n) {
+    const unsigned source = node(rng);
+    auto expect = Djikstra::Solve(graph, source);
+
+    // A full solve leaves every distance and parent in the workspace.
+    Djikstra::Solve(graph, source, workspace);
+    for (const auto& target: graph.Nodes()) {
+      const auto index = graph.Index(target);
+      ASSERT_EQ(workspace.Distance(index), expect.Distance(target));
+      ASSERT_EQ(workspace.Reached(index),
+                expect.Distance(target) != graph.DefaultValue());
+    }
+    ASSERT_EQ(workspace.Parent(graph.Index(source)),
+              Djikstra::Workspace<Graph>::kNone);
+
+    // Point to point queries reuse the same workspace.
+    for (std::size_t m = 0; m < 10; ++m) {
+      const unsigned target = node(rng);
+      ASSERT_EQ(Djikstra::Query(graph, source, target, workspace),
+                expect.Distance(target));
+
+      auto path = Djikstra::Path(graph, source, target, workspace);
+      ASSERT_EQ(path.distance, expect.Distance(target));
+      if (path.Found()) {
+        ASSERT_EQ(path.nodes.front(), source);
+        ASSERT_EQ(path.nodes.back(), target);
+      }
+
+      ASSERT_EQ(Djikstra::BidirectionalQuery(compressed, reverse, source, target,
+                                             forward_compressed,
+                                             backward_compressed),
+                expect.Distance(target));
+    }
+  }
+}
+
+TEST(Djikstra, SolveWithin) {
+  Graph graph;
+  graph.AddEdge(0, 1, 1.0);
+  graph.AddEdge(1, 2, 1.0);
+  graph.AddEdge(2, 3, 1.0);
+  graph.AddEdge(3, 4, 3.0);
+  graph.AddEdge(0, 3, 2.5);
+  graph.AddEdge(3, 4, 1);
+
+  auto within = Djikstra::SolveWithin(graph, 0, 2.0f);
+  ASSERT_EQ(within.size(), 3);
+  ASSERT_EQ(within[0].node, 0U);
+  ASSERT_FLOAT_EQ(within[0].distance, 0.0);
+  ASSERT_EQ(within[1].node, 1U);
+  ASSERT_FLOAT_EQ(within[1].distance, 1.0);
+  ASSERT_EQ(within[2].node, 2U);
+  ASSERT_FLOAT_EQ(within[2].distance, 2.0);
+
+  ASSERT_EQ(Djikstra::SolveWithin(graph, 0, 10.0f).size(), 5);
+  ASSERT_EQ(Djikstra::SolveWithin(graph, 0, 0.5f).size(), 1);
+}
+
+TEST(Djikstra, SolveWithinRandom) {
+  std::mt19937 rng(29);
+  std::uniform_int_distribution<unsigned> node(0, 299);
+  std::uniform_int_distribution<unsigned> weight(1, 64);
+
+  Graph graph({.directed = true});
+  for (std::size_t n = 0; n < 1200; ++n)
+    graph.AddEdge(node(rng), node(rng), weight(rng) / 4.0f);
+
+  Djikstra::Workspace<Graph> workspace(graph);
+  for (std::size_t n = 0; n < 20; ++n) {
+    const auto start = graph.Nodes()[node(rng) % graph.NodeCount()];
+    const float radius = 10.0f + n;
+    auto expect = Djikstra::Solve(graph, start);
+
+    std::size_t inside = 0;
+    for (const auto& target: graph.Nodes())
+      inside += expect.Distance(target) <= radius;
+
+    auto within = Djikstra::SolveWithin(graph, start, radius, workspace);
+    ASSERT_EQ(within.size(), inside);
+    for (std::size_t m = 0; m < within.size(); ++m) {
+      ASSERT_EQ(within[m].distance, expect.Distance(within[m].node));
+      if (m > 0) {
+        ASSERT_LE(within[m - 1].distance, within[m].distance);
+      }
+    }
+  }
+}
+
+TEST(Djikstra, Nearest) {
+  Graph graph;
+  for (unsigned n = 0; n < 10; ++n)
+    graph.AddEdge(n, n + 1, 1.0f + n);
+
+  auto even = [](unsigned node) { return node % 2 == 0; };
+
+  auto nearest = Djikstra::Nearest(graph, 5, 3, even);
+  ASSERT_EQ(nearest.size(), 3);
+  ASSERT_EQ(nearest[0].node, 4U);
+  ASSERT_FLOAT_EQ(nearest[0].distance, 5.0);
+  ASSERT_EQ(nearest[1].node, 6U);
+  ASSERT_FLOAT_EQ(nearest[1].distance, 6.0);
+  ASSERT_EQ(nearest[2].node, 2U);
+  ASSERT_FLOAT_EQ(nearest[2].distance, 12.0);
+
+  // The start node counts, and asking for more than exist returns them all.
+  auto all = Djikstra::Nearest(graph, 4, 100, even);
+  ASSERT_EQ(all.size(), 6);
+  ASSERT_EQ(all[0].node, 4U);
+  ASSERT_FLOAT_EQ(all[0].distance, 0.0);
+
+  ASSERT_TRUE(Djikstra::Nearest(graph, 4, 0, even).empty());
+}
+
+TEST(Djikstra, Predecessors) {
+  Graph graph({.directed = true});
+  graph.AddEdge(0, 1, 1.0);
+  graph.AddEdge(1, 2, 1.0);
+  graph.AddEdge(2, 3, 1.0);
+  graph.AddEdge(0, 3, 3.5);
+  graph.AddEdge(5, 0, 1.0);
+
+  auto solution = Djikstra::Solve<Record::PREDECESSORS>(graph, 0);
+
+  auto path = solution.Path(3);
+  ASSERT_FLOAT_EQ(path.distance, 3.0);
+  ASSERT_EQ(path.nodes, (std::vector<unsigned>{0, 1, 2, 3}));
+
+  path = solution.Path(0);
+  ASSERT_FLOAT_EQ(path.distance, 0.0);
+  ASSERT_EQ(path.nodes, (std::vector<unsigned>{0}));
+
+  ASSERT_FALSE(solution.Path(5).Found());
+
+  static_assert(
+      sizeof(decltype(Djikstra::Solve(graph, 0)))
+    < sizeof(decltype(solution))
+  );
+}
+
+TEST(Djikstra, PredecessorsMulti) {
+  std::mt19937 rng(17);
+  std::uniform_int_distribution<unsigned> node(0, 99);
+  std::uniform_real_distribution<float> weight(0.5, 5.0);
+
+  Graph graph({.directed = true});
+  for (std::size_t n = 0; n < 400; ++n)
+    graph.AddEdge(node(rng), node(rng), weight(rng));
+
+  auto solution = Djikstra::Solve<Record::PREDECESSORS>(graph, {.threads = 3});
+
+  for (const auto& fr: graph.Nodes()) {
+    for (const auto& to: graph.Nodes()) {
+      const auto path = solution.Path(fr, to);
+      if (!path.Found()) {
+        ASSERT_EQ(solution.Distance(fr, to), graph.DefaultValue());
+        continue;
+      }
+
+      ASSERT_EQ(path.nodes.front(), fr);
+      ASSERT_EQ(path.nodes.back(), to);
+      ASSERT_EQ(path.distance, solution.Distance(fr, to));
+
+      // Every hop is itself a shortest path.
+      for (std::size_t n = 1; n < path.nodes.size(); ++n)
+        ASSERT_LE(
+            solution.Distance(fr, path.nodes[n - 1]),
+            solution.Distance(fr, path.nodes[n])
+        );
+    }
+  }
+}
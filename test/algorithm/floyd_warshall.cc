@@ -1,10 +1,17 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cstdint>
+#include <random>
 #include <string>
+#include <vector>
 
+#include "search/algorithm/bellman_ford.hh"
 #include "search/algorithm/floyd_warshall.hh"
+#include "search/algorithm/incremental_update.hh"
 #include "search/graph/neighbor_graph.hh"
 #include "search/matrix/dense.hh"
+#include "search/matrix/fixed_point.hh"
 #include "search/matrix/sparse_map.hh"
 
 using namespace search;
@@ -66,3 +73,188 @@ TEST(FloydWarshall, Sparse) {
   ASSERT_FLOAT_EQ(solution.Distance(3, 1), 2.0);
   ASSERT_FLOAT_EQ(solution.Distance(4, 1), 3.0);
 }
+
+TEST(FloydWarshall, Predecessors) {
+  Graph graph({.directed = true});
+  graph.AddEdge(0, 1, 1.0);
+  graph.AddEdge(1, 2, 1.0);
+  graph.AddEdge(2, 3, 1.0);
+  graph.AddEdge(0, 3, 3.5);
+  graph.AddEdge(3, 0, 1.0);
+  graph.AddEdge(4, 3, 1.0);
+
+  auto solution = FloydWarshall::Solve<Record::PREDECESSORS>(graph);
+
+  auto path = solution.Path(0, 3);
+  ASSERT_FLOAT_EQ(path.distance, 3.0);
+  ASSERT_EQ(path.nodes, (std::vector<unsigned>{0, 1, 2, 3}));
+
+  path = solution.Path(2, 1);
+  ASSERT_FLOAT_EQ(path.distance, 3.0);
+  ASSERT_EQ(path.nodes, (std::vector<unsigned>{2, 3, 0, 1}));
+
+  path = solution.Path(4, 4);
+  ASSERT_FLOAT_EQ(path.distance, 0.0);
+  ASSERT_EQ(path.nodes, (std::vector<unsigned>{4}));
+
+  ASSERT_FALSE(solution.Path(0, 4).Found());
+}
+
+TEST(FloydWarshall, ParallelEdges) {
+  Graph graph({.directed = true});
+  graph.AddEdge(0, 1, 1.0);
+  graph.AddEdge(0, 1, 4.0);
+  graph.AddEdge(1, 2, 3.0);
+  graph.AddEdge(1, 2, 2.0);
+
+  auto solution = FloydWarshall::Solve(graph);
+
+  ASSERT_FLOAT_EQ(solution.Distance(0, 0), 0.0);
+  ASSERT_FLOAT_EQ(solution.Distance(0, 1), 1.0);
+  ASSERT_FLOAT_EQ(solution.Distance(0, 2), 3.0);
+  ASSERT_EQ(solution.Distance(2, 0), graph.DefaultValue());
+}
+
+TEST(FloydWarshall, Blocked) {
+  using IntGraph = NeighborGraph<unsigned, int>;
+
+  std::mt19937 rng(37);
+  std::uniform_int_distribution<unsigned> node(0, 149);
+  std::uniform_int_distribution<int> weight(1, 50);
+
+  IntGraph graph({.directed = true});
+  for (std::size_t n = 0; n < 700; ++n)
+    graph.AddEdge(node(rng), node(rng), weight(rng));
+
+  for (std::size_t block: {0, 1, 7, 16, 64, 1000}) {
+    auto actual = FloydWarshall::Solve<Record::PREDECESSORS>(graph, {.block = block});
+    auto sparse = FloydWarshall::Solve<
+        Record::DISTANCES,
+        IntGraph,
+        SparseMapMatrix<int>
+    >(graph, {.block = block});
+
+    for (const auto& fr: graph.Nodes()) {
+      auto expect = BellmanFord::Solve(graph, fr);
+
+      for (const auto& to: graph.Nodes()) {
+        ASSERT_EQ(expect.Distance(to), actual.Distance(fr, to));
+        ASSERT_EQ(expect.Distance(to), sparse.Distance(fr, to));
+
+        const auto path = actual.Path(fr, to);
+        ASSERT_EQ(path.Found(), expect.Distance(to) != graph.DefaultValue());
+        if (path.Found()) {
+          ASSERT_EQ(path.nodes.front(), fr);
+          ASSERT_EQ(path.nodes.back(), to);
+        }
+      }
+    }
+  }
+}
+
+TEST(FloydWarshall, MultiThreaded) {
+  std::mt19937 rng(43);
+  std::uniform_int_distribution<unsigned> node(0, 299);
+  std::uniform_int_distribution<int> weight(0, 20);
+
+  Graph graph({.directed = true});
+  for (std::size_t n = 0; n < 2000; ++n)
+    graph.AddEdge(node(rng), node(rng), weight(rng));
+
+  // Integral weights keep every order of summation exact.
+  auto expect = FloydWarshall::Solve(graph, {.block = 0});
+
+  for (std::size_t block: {0, 16, 64}) {
+    for (std::size_t threads: {2, 5, 0}) {
+      auto actual = FloydWarshall::Solve(graph, {.block = block, .threads = threads});
+      auto paths  = FloydWarshall::Solve<Record::PREDECESSORS>(
+          graph, {.block = block, .threads = threads});
+
+      for (const auto& fr: graph.Nodes()) {
+        for (const auto& to: graph.Nodes()) {
+          ASSERT_EQ(expect.Distance(fr, to), actual.Distance(fr, to));
+          ASSERT_EQ(expect.Distance(fr, to), paths.Distance(fr, to));
+
+          const auto path = paths.Path(fr, to);
+          ASSERT_EQ(path.Found(), expect.Distance(fr, to) != graph.DefaultValue());
+          if (path.Found()) {
+            ASSERT_EQ(path.nodes.front(), fr);
+            ASSERT_EQ(path.nodes.back(), to);
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(FloydWarshall, FixedPoint) {
+  std::mt19937 rng(61);
+  std::uniform_int_distribution<unsigned> node(0, 149);
+  std::uniform_int_distribution<int> weight(0, 40);
+
+  // Halves are exact in float and in fixed point of scale 2.
+  Graph graph({.directed = true});
+  for (std::size_t n = 0; n < 700; ++n)
+    graph.AddEdge(node(rng), node(rng), weight(rng) * 0.5f);
+
+  auto expect = FloydWarshall::Solve(graph);
+
+  // Past 1000 the fine scale saturates, sums included.
+  for (double scale: {2.0, 64.0}) {
+    const FixedPoint<std::uint16_t> fixed(scale);
+
+    for (std::size_t block: {0, 16, 64}) {
+      auto dense = FloydWarshall::Solve<
+          Record::DISTANCES,
+          Graph,
+          DenseMatrix<std::uint16_t>
+      >(graph, {.block = block, .threads = 2, .scale = scale});
+      auto paths = FloydWarshall::Solve<
+          Record::PREDECESSORS,
+          Graph,
+          DenseMatrix<std::uint16_t>
+      >(graph, {.block = block, .scale = scale});
+      auto sparse = FloydWarshall::Solve<
+          Record::DISTANCES,
+          Graph,
+          SparseMapMatrix<std::uint16_t>
+      >(graph, {.block = block, .scale = scale});
+
+      for (const auto& fr: graph.Nodes()) {
+        for (const auto& to: graph.Nodes()) {
+          const std::uint16_t stored = fixed.Encode(expect.Distance(fr, to));
+          ASSERT_EQ(stored, dense.Distance(fr, to));
+          ASSERT_EQ(stored, paths.Distance(fr, to));
+          ASSERT_EQ(stored, sparse.Distance(fr, to));
+
+          if (stored != fixed.kSentinal) {
+            ASSERT_FLOAT_EQ(fixed.Decode<float>(stored), expect.Distance(fr, to));
+          }
+        }
+      }
+    }
+  }
+
+  // Live updates saturate the same way.
+  using Fixed = DenseMatrix<std::uint16_t>;
+  auto live = FloydWarshall::Solve<Record::DISTANCES, Graph, Fixed>(graph, {.scale = 64});
+  for (std::size_t n = 0; n < 20; ++n) {
+    const unsigned fr = node(rng);
+    const unsigned to = node(rng);
+    const float edge  = weight(rng) * 0.5f;
+    graph.AddEdge(fr, to, edge);
+    IncrementalUpdate::DecreaseEdge(
+        live, fr, to, FixedPoint<std::uint16_t>(64).Encode(edge));
+  }
+
+  auto fresh = FloydWarshall::Solve<Record::DISTANCES, Graph, Fixed>(graph, {.scale = 64});
+  for (const auto& fr: graph.Nodes())
+    for (const auto& to: graph.Nodes())
+      ASSERT_EQ(fresh.Distance(fr, to), live.Distance(fr, to));
+
+  // Unsigned storage has no room for negative edges.
+  Graph signed_graph({.directed = true});
+  signed_graph.AddEdge(0, 1, -1.0);
+  ASSERT_THROW((FloydWarshall::Solve<Record::DISTANCES, Graph, DenseMatrix<std::uint16_t>>(
+      signed_graph)), FixedPointError);
+}
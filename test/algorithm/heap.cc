@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "search/algorithm/heap.hh"
+
+using namespace search;
+
+template <typename Heap>
+static void
+CheckSorted(Heap& heap, std::size_t count) {
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int> dist(0, 1000);
+
+  std::vector<int> keys(count);
+  for (std::size_t n = 0; n < count; ++n) {
+    keys[n] = dist(rng);
+    heap.Push(n, keys[n]);
+  }
+
+  // Lower a third of the keys.
+  for (std::size_t n = 0; n < count; n += 3) {
+    keys[n] -= 500;
+    heap.Push(n, keys[n]);
+  }
+
+  std::vector<bool> seen(count, false);
+  int last = std::numeric_limits<int>::min();
+  std::size_t popped = 0;
+
+  while (!heap.Empty()) {
+    const auto entry = heap.Pop();
+    if (seen[entry.index])
+      continue;
+
+    seen[entry.index] = true;
+    ASSERT_EQ(entry.key, keys[entry.index]);
+    ASSERT_GE(entry.key, last);
+    last = entry.key;
+    ++popped;
+  }
+
+  ASSERT_EQ(popped, count);
+}
+
+TEST(DaryHeap, Binary) {
+  DaryHeap<int, std::uint32_t, 2> heap(257);
+  CheckSorted(heap, 257);
+}
+
+TEST(DaryHeap, Quaternary) {
+  DaryHeap<int> heap(1000);
+  CheckSorted(heap, 1000);
+}
+
+TEST(DaryHeap, DecreaseKey) {
+  DaryHeap<int> heap(4);
+  heap.Push(0, 10);
+  heap.Push(1, 20);
+  heap.Push(2, 30);
+  heap.Push(2, 5);
+  heap.Push(1, 25);
+
+  ASSERT_EQ(heap.Size(), 3);
+  ASSERT_TRUE(heap.Contains(1));
+  ASSERT_FALSE(heap.Contains(3));
+
+  ASSERT_EQ(heap.Pop().index, 2U);
+  ASSERT_EQ(heap.Pop().index, 0U);
+  ASSERT_EQ(heap.Top().key, 20);
+
+  heap.Clear();
+  ASSERT_TRUE(heap.Empty());
+  ASSERT_FALSE(heap.Contains(1));
+}
+
+TEST(LazyHeap, Sorted) {
+  LazyHeap<int> heap;
+  CheckSorted(heap, 1000);
+}
+
+template <typename Heap>
+static void
+CheckMonotone(Heap& heap, unsigned max_step) {
+  std::mt19937 rng(11);
+  std::uniform_int_distribution<unsigned> step(0, max_step);
+
+  // Simulate a shortest path search: every push is the last popped key
+  // plus a bounded step.
+  heap.Push(0, 0U);
+  std::uint32_t next = 1;
+  unsigned last = 0;
+
+  for (std::size_t n = 0; n < 5000 && !heap.Empty(); ++n) {
+    const auto entry = heap.Pop();
+    ASSERT_GE(entry.key, last);
+    last = entry.key;
+
+    if (next < 4000) {
+      heap.Push(next++, last + step(rng));
+      heap.Push(next++, last + step(rng));
+    }
+  }
+
+  heap.Clear();
+  ASSERT_TRUE(heap.Empty());
+  ASSERT_EQ(heap.Size(), 0);
+}
+
+TEST(RadixHeap, Monotone) {
+  RadixHeap<unsigned> heap;
+  CheckMonotone(heap, 1000000);
+}
+
+TEST(RadixHeap, Duplicates) {
+  RadixHeap<std::uint8_t> heap;
+  heap.Push(3, 200);
+  heap.Push(1, 7);
+  heap.Push(2, 7);
+  heap.Push(3, 9);
+
+  ASSERT_EQ(heap.Pop().key, 7);
+  ASSERT_EQ(heap.Pop().key, 7);
+  ASSERT_EQ(heap.Pop().index, 3U);
+  ASSERT_EQ(heap.Pop().key, 200);
+  ASSERT_TRUE(heap.Empty());
+}
+
+TEST(BucketQueue, Monotone) {
+  BucketQueue<unsigned, std::uint32_t, 16> heap;
+  CheckMonotone(heap, 16);
+}
+
+TEST(BucketQueue, OutOfRange) {
+  BucketQueue<unsigned, std::uint32_t, 16> heap;
+  heap.Push(0, 16);
+  ASSERT_THROW(heap.Push(1, 17), HeapError);
+
+  ASSERT_EQ(heap.Pop().key, 16U);
+  heap.Push(2, 32);
+  ASSERT_THROW(heap.Push(3, 15), HeapError);
+  ASSERT_EQ(heap.Pop().key, 32U);
+  ASSERT_TRUE(heap.Empty());
+}
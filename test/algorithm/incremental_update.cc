@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "search/algorithm/floyd_warshall.hh"
+#include "search/algorithm/incremental_update.hh"
+#include "search/graph/neighbor_graph.hh"
+#include "search/matrix/dense.hh"
+#include "search/matrix/sparse_map.hh"
+
+using namespace search;
+
+using Graph = NeighborGraph<unsigned, float>;
+
+TEST(IncrementalUpdate, DecreaseEdge) {
+  using IntGraph = NeighborGraph<unsigned, int>;
+  using Update   = EdgeUpdate<unsigned, int>;
+
+  std::mt19937 rng(53);
+  std::uniform_int_distribution<unsigned> node(0, 119);
+  std::uniform_int_distribution<int> weight(-5, 40);
+
+  // Non-negative weights first, so every node is known and no cycle can
+  // turn negative through the later edges.
+  IntGraph graph({.directed = true});
+  for (unsigned idx = 0; idx < 120; ++idx)
+    graph.AddEdge(idx, (idx + 1) % 120, 40);
+  for (std::size_t n = 0; n < 300; ++n)
+    graph.AddEdge(node(rng), node(rng), 10 + weight(rng));
+
+  auto dense  = FloydWarshall::Solve(graph);
+  auto paths  = FloydWarshall::Solve<Record::PREDECESSORS>(graph);
+  auto sparse = FloydWarshall::Solve<
+      Record::DISTANCES,
+      IntGraph,
+      SparseMapMatrix<int>
+  >(graph);
+  auto batch  = FloydWarshall::Solve(graph);
+
+  std::vector<Update> updates;
+  for (std::size_t n = 0; n < 60; ++n) {
+    const unsigned fr = node(rng);
+    const unsigned to = node(rng);
+    const int edge = std::max(weight(rng), -dense.Distance(to, fr));
+
+    graph.AddEdge(fr, to, edge);
+    updates.push_back({fr, to, edge});
+
+    ASSERT_EQ(IncrementalUpdate::DecreaseEdge(dense, fr, to, edge),
+              IncrementalUpdate::DecreaseEdge(paths, fr, to, edge));
+    IncrementalUpdate::DecreaseEdge(sparse, fr, to, edge);
+  }
+  ASSERT_TRUE(IncrementalUpdate::DecreaseEdges(batch, updates));
+
+  auto expect = FloydWarshall::Solve(graph);
+  for (const auto& fr: graph.Nodes()) {
+    for (const auto& to: graph.Nodes()) {
+      ASSERT_EQ(expect.Distance(fr, to), dense.Distance(fr, to));
+      ASSERT_EQ(expect.Distance(fr, to), paths.Distance(fr, to));
+      ASSERT_EQ(expect.Distance(fr, to), sparse.Distance(fr, to));
+      ASSERT_EQ(expect.Distance(fr, to), batch.Distance(fr, to));
+
+      const auto path = paths.Path(fr, to);
+      ASSERT_TRUE(path.Found());
+      ASSERT_EQ(path.nodes.front(), fr);
+      ASSERT_EQ(path.nodes.back(), to);
+
+      // The recorded route adds up to the distance.
+      int length = 0;
+      for (std::size_t n = 1; n < path.nodes.size(); ++n)
+        length += expect.Distance(path.nodes[n - 1], path.nodes[n]);
+      ASSERT_EQ(length, expect.Distance(fr, to));
+    }
+  }
+
+  // Not an improvement.
+  ASSERT_FALSE(IncrementalUpdate::DecreaseEdge(dense, 0, 1, 1000));
+}
+
+TEST(IncrementalUpdate, NegativeCycle) {
+  Graph graph({.directed = true});
+  graph.AddEdge(0, 1, 1.0);
+  graph.AddEdge(1, 2, 1.0);
+
+  auto solution = FloydWarshall::Solve<Record::PREDECESSORS>(graph);
+  ASSERT_THROW(IncrementalUpdate::DecreaseEdge(solution, 2, 0, -2.5),
+               NegativeCycleError);
+  ASSERT_EQ(solution.Distance(2, 0), graph.DefaultValue());
+
+  ASSERT_TRUE(IncrementalUpdate::DecreaseEdge(solution, 2, 0, -2.0));
+  ASSERT_FLOAT_EQ(solution.Distance(1, 0), -1.0);
+  ASSERT_EQ(solution.Path(1, 0).nodes, (std::vector<unsigned>{1, 2, 0}));
+}
@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "search/algorithm/bellman_ford.hh"
+#include "search/algorithm/johnson.hh"
+#include "search/graph/compressed_neighbor_graph.hh"
+#include "search/matrix/dense.hh"
+#include "search/matrix/sparse_map.hh"
+
+using namespace search;
+
+using Graph = NeighborGraph<unsigned, float>;
+
+TEST(Johnson, Negative) {
+  Graph graph({.directed = true});
+  graph.AddEdge(0, 1,  3.0);
+  graph.AddEdge(0, 2,  8.0);
+  graph.AddEdge(1, 2, -4.0);
+  graph.AddEdge(2, 3,  2.0);
+  graph.AddEdge(3, 0,  1.0);
+  graph.AddEdge(3, 1,  5.0);
+  graph.AddEdge(4, 0,  0.5);
+
+  auto solution = Johnson::Solve<Record::PREDECESSORS>(graph);
+
+  ASSERT_FLOAT_EQ(solution.Distance(0, 2), -1.0);
+  ASSERT_FLOAT_EQ(solution.Distance(0, 3),  1.0);
+  ASSERT_FLOAT_EQ(solution.Distance(3, 2),  0.0);
+  ASSERT_FLOAT_EQ(solution.Distance(2, 1),  6.0);
+  ASSERT_FLOAT_EQ(solution.Distance(4, 2), -0.5);
+  ASSERT_EQ(solution.Distance(0, 4), graph.DefaultValue());
+
+  auto path = solution.Path(4, 3);
+  ASSERT_FLOAT_EQ(path.distance, 1.5);
+  ASSERT_EQ(path.nodes, (std::vector<unsigned>{4, 0, 1, 2, 3}));
+
+  ASSERT_FALSE(solution.Path(1, 4).Found());
+}
+
+TEST(Johnson, NegativeCycle) {
+  Graph graph({.directed = true});
+  graph.AddEdge(0, 1,  1.0);
+  graph.AddEdge(1, 2,  1.0);
+  graph.AddEdge(2, 0, -2.5);
+  graph.AddEdge(3, 0,  1.0);
+
+  ASSERT_THROW(Johnson::Solve(graph), BellmanFordNegativeWeight);
+}
+
+TEST(Johnson, BellmanFord) {
+  using IntGraph = NeighborGraph<unsigned, int>;
+
+  std::mt19937 rng(31);
+  std::uniform_int_distribution<unsigned> node(0, 199);
+  std::uniform_int_distribution<int> weight(0, 20);
+  std::uniform_int_distribution<int> potential(-30, 30);
+
+  // Reduced costs keep every cycle non-negative.
+  std::vector<int> p(200);
+  for (auto& value: p)
+    value = potential(rng);
+
+  IntGraph graph({.directed = true});
+  for (std::size_t n = 0; n < 800; ++n) {
+    const unsigned fr = node(rng);
+    const unsigned to = node(rng);
+    graph.AddEdge(fr, to, weight(rng) + p[fr] - p[to]);
+  }
+
+  const auto compressed = CompressedNeighborGraph<unsigned, int>(graph);
+
+  for (std::size_t threads: {1, 4}) {
+    auto dense  = Johnson::Solve(compressed, {.threads = threads});
+    auto sparse = Johnson::Solve<
+        Record::DISTANCES,
+        CompressedNeighborGraph<unsigned, int>,
+        SparseMapMatrix<int>
+    >(compressed, {.threads = threads});
+
+    for (const auto& fr: graph.Nodes()) {
+      auto expect = BellmanFord::Solve(graph, fr);
+
+      for (const auto& to: graph.Nodes()) {
+        ASSERT_EQ(expect.Distance(to), dense.Distance(fr, to));
+        ASSERT_EQ(expect.Distance(to), sparse.Distance(fr, to));
+      }
+    }
+  }
+}
+
+TEST(Johnson, String) {
+  using StringGraph = NeighborGraph<std::string, float>;
+  StringGraph graph({.directed = true});
+  graph.AddEdge("a", "b",  2.0);
+  graph.AddEdge("b", "c", -1.0);
+  graph.AddEdge("a", "c",  1.5);
+
+  auto solution = Johnson::Solve(graph);
+
+  ASSERT_FLOAT_EQ(solution.Distance("a", "c"), 1.0);
+  ASSERT_FLOAT_EQ(solution.Distance("a", "a"), 0.0);
+  ASSERT_EQ(solution.Distance("c", "a"), graph.DefaultValue());
+}
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "search/algorithm/djikstra.hh"
+#include "search/algorithm/landmarks.hh"
+#include "search/graph/compressed_neighbor_graph.hh"
+#include "search/graph/neighbor_graph.hh"
+
+using namespace search;
+
+using Graph           = NeighborGraph<unsigned, float>;
+using CompressedGraph = CompressedNeighborGraph<unsigned, float>;
+
+static Graph
+MakeRandom(unsigned seed, bool directed) {
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<unsigned> node(0, 199);
+  std::uniform_real_distribution<float> weight(1.0, 10.0);
+
+  Graph graph({.directed = directed});
+  for (unsigned n = 0; n < 200; ++n)
+    graph.AddNode(n);
+  for (std::size_t n = 0; n < 800; ++n)
+    graph.AddEdge(node(rng), node(rng), weight(rng));
+  return graph;
+}
+
+TEST(Landmarks, Tables) {
+  auto graph = MakeRandom(1, false);
+  Landmarks<float> landmarks(graph, {.count = 4});
+
+  ASSERT_EQ(landmarks.Indices().size(), 4);
+  ASSERT_EQ(landmarks.From().Rows(), 4);
+  ASSERT_EQ(landmarks.From().Cols(), graph.NodeCount());
+
+  for (std::size_t k = 0; k < 4; ++k) {
+    const auto landmark = landmarks.Indices()[k];
+    auto expect = Djikstra::Solve(graph, graph.Node(landmark));
+    for (const auto& node: graph.Nodes()) {
+      ASSERT_EQ(landmarks.From().At(k, graph.Index(node)), expect.Distance(node));
+      ASSERT_EQ(landmarks.To().At(k, graph.Index(node)), expect.Distance(node));
+    }
+  }
+
+  // Landmarks are distinct.
+  auto indices = landmarks.Indices();
+  std::sort(indices.begin(), indices.end());
+  ASSERT_EQ(std::unique(indices.begin(), indices.end()), indices.end());
+}
+
+TEST(Landmarks, Admissible) {
+  auto graph = MakeRandom(2, true);
+  CompressedGraph compressed(graph);
+  auto reverse = compressed.Reverse();
+
+  for (auto selection: {LandmarkSelection::FARTHEST, LandmarkSelection::AVOID}) {
+    Landmarks<float> landmarks(compressed, reverse,
+                               {.count = 8, .selection = selection});
+
+    for (const auto& source: graph.Nodes()) {
+      auto expect = Djikstra::Solve(compressed, source);
+      for (const auto& target: graph.Nodes()) {
+        const float bound = landmarks.LowerBound(
+            compressed.Index(source), compressed.Index(target));
+        if (expect.Distance(target) != graph.DefaultValue()) {
+          ASSERT_LE(bound, expect.Distance(target) * (1 + 1e-5));
+        }
+      }
+    }
+  }
+}
+
+TEST(Landmarks, Path) {
+  auto graph = MakeRandom(3, true);
+  CompressedGraph compressed(graph);
+  Landmarks<float> landmarks(compressed, compressed.Reverse(), {.count = 6});
+
+  std::mt19937 rng(4);
+  std::uniform_int_distribution<unsigned> node(0, 199);
+
+  for (std::size_t n = 0; n < 100; ++n) {
+    const unsigned source = node(rng);
+    const unsigned target = node(rng);
+    const float    expect = Djikstra::Query(compressed, source, target);
+
+    auto path = landmarks.Path(compressed, source, target);
+    ASSERT_FLOAT_EQ(path.distance, expect);
+    if (path.Found()) {
+      ASSERT_EQ(path.nodes.front(), source);
+      ASSERT_EQ(path.nodes.back(), target);
+    }
+  }
+}
+
+TEST(Landmarks, Disconnected) {
+  Graph graph;
+  graph.AddEdge(0, 1, 1.0);
+  graph.AddEdge(1, 2, 1.0);
+  graph.AddEdge(10, 11, 1.0);
+
+  Landmarks<float> landmarks(graph, {.count = 2, .selection = LandmarkSelection::FARTHEST});
+
+  // The second landmark lands in the component the first cannot reach.
+  const auto& indices = landmarks.Indices();
+  ASSERT_NE(graph.Node(indices[0]) < 10, graph.Node(indices[1]) < 10);
+
+  ASSERT_FLOAT_EQ(landmarks.Path(graph, 0, 2).distance, 2.0);
+  ASSERT_FALSE(landmarks.Path(graph, 0, 11).Found());
+}
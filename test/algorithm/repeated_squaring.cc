@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "search/algorithm/floyd_warshall.hh"
+#include "search/algorithm/repeated_squaring.hh"
+#include "search/graph/neighbor_graph.hh"
+
+using namespace search;
+
+using Graph = NeighborGraph<unsigned, float>;
+
+TEST(RepeatedSquaring, Dense) {
+  Graph graph;
+  graph.AddEdge(0, 1, 1.0);
+  graph.AddEdge(1, 2, 1.0);
+  graph.AddEdge(2, 3, 1.0);
+  graph.AddEdge(3, 4, 3.0);
+  graph.AddEdge(0, 3, 2.5);
+  graph.AddEdge(3, 4, 1);
+
+  auto solution = RepeatedSquaring::Solve(graph);
+
+  ASSERT_FLOAT_EQ(solution.Distance(0, 0), 0.0);
+  ASSERT_FLOAT_EQ(solution.Distance(0, 1), 1.0);
+  ASSERT_FLOAT_EQ(solution.Distance(0, 2), 2.0);
+  ASSERT_FLOAT_EQ(solution.Distance(0, 3), 2.5);
+  ASSERT_FLOAT_EQ(solution.Distance(0, 4), 3.5);
+  ASSERT_FLOAT_EQ(solution.Distance(4, 1), 3.0);
+}
+
+TEST(RepeatedSquaring, Chain) {
+  // A path of 100 hops needs every one of the 7 squares.
+  Graph graph({.directed = true});
+  for (unsigned idx = 0; idx < 100; ++idx)
+    graph.AddEdge(idx, idx + 1, 1.0);
+
+  auto solution = RepeatedSquaring::Solve(graph, {.block = 16});
+
+  ASSERT_FLOAT_EQ(solution.Distance(0, 100), 100.0);
+  ASSERT_FLOAT_EQ(solution.Distance(37, 64), 27.0);
+  ASSERT_EQ(solution.Distance(64, 37), graph.DefaultValue());
+}
+
+TEST(RepeatedSquaring, Random) {
+  using IntGraph = NeighborGraph<unsigned, int>;
+
+  std::mt19937 rng(47);
+  std::uniform_int_distribution<unsigned> node(0, 199);
+  std::uniform_int_distribution<int> weight(1, 50);
+
+  IntGraph graph({.directed = true});
+  for (std::size_t n = 0; n < 900; ++n)
+    graph.AddEdge(node(rng), node(rng), weight(rng));
+
+  auto expect = FloydWarshall::Solve(graph);
+
+  for (std::size_t block: {0, 8, 256}) {
+    for (std::size_t threads: {1, 3, 0}) {
+      auto actual = RepeatedSquaring::Solve(graph, {.block = block, .threads = threads});
+
+      for (const auto& fr: graph.Nodes())
+        for (const auto& to: graph.Nodes())
+          ASSERT_EQ(expect.Distance(fr, to), actual.Distance(fr, to));
+    }
+  }
+}
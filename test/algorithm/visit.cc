@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "search/algorithm/djikstra.hh"
+#include "search/algorithm/visit.hh"
+#include "search/graph/compressed_neighbor_graph.hh"
+#include "search/graph/neighbor_graph.hh"
+
+using namespace search;
+
+using Graph = NeighborGraph<unsigned, float>;
+
+TEST(MultiSourceBfs, Line) {
+  Graph graph({.directed = true});
+  graph.AddEdge(0, 1, 7.0);
+  graph.AddEdge(1, 2, 7.0);
+  graph.AddEdge(2, 3, 7.0);
+  graph.AddEdge(0, 3, 0.5);
+  graph.AddEdge(4, 0, 1.0);
+
+  const std::vector<unsigned> sources{0, 2, 0};
+  auto hops = MultiSourceBfs::Solve(graph, sources);
+  constexpr auto kUnreached = MultiSourceBfs::kUnreached<std::uint16_t>;
+
+  ASSERT_EQ(hops.Rows(), 3);
+  ASSERT_EQ(hops.Cols(), 5);
+
+  ASSERT_EQ(hops.At(0, graph.Index(0)), 0);
+  ASSERT_EQ(hops.At(0, graph.Index(1)), 1);
+  ASSERT_EQ(hops.At(0, graph.Index(2)), 2);
+  ASSERT_EQ(hops.At(0, graph.Index(3)), 1);
+  ASSERT_EQ(hops.At(0, graph.Index(4)), kUnreached);
+
+  ASSERT_EQ(hops.At(1, graph.Index(2)), 0);
+  ASSERT_EQ(hops.At(1, graph.Index(3)), 1);
+  ASSERT_EQ(hops.At(1, graph.Index(0)), kUnreached);
+
+  for (std::size_t idx = 0; idx < hops.Cols(); ++idx)
+    ASSERT_EQ(hops.At(0, idx), hops.At(2, idx));
+}
+
+TEST(MultiSourceBfs, Saturate) {
+  Graph graph({.directed = true});
+  for (unsigned n = 0; n < 300; ++n)
+    graph.AddEdge(n, n + 1, 1.0);
+
+  const std::vector<unsigned> sources{0};
+  auto hops = MultiSourceBfs::Solve<std::uint8_t>(graph, sources);
+
+  ASSERT_EQ(hops.At(0, graph.Index(254)), 254);
+  ASSERT_EQ(hops.At(0, graph.Index(255)), MultiSourceBfs::kUnreached<std::uint8_t>);
+  ASSERT_EQ(hops.At(0, graph.Index(300)), MultiSourceBfs::kUnreached<std::uint8_t>);
+}
+
+template <typename Bfs>
+void
+CompareDjikstra(std::size_t threads) {
+  std::mt19937 rng(23);
+  std::uniform_int_distribution<unsigned> node(0, 399);
+
+  Graph graph({.directed = true});
+  for (std::size_t n = 0; n < 1200; ++n)
+    graph.AddEdge(node(rng), node(rng), 1.0);
+
+  const auto compressed = CompressedNeighborGraph<unsigned, float>(graph);
+
+  const auto& nodes = graph.Nodes();
+  std::uniform_int_distribution<std::size_t> pick(0, nodes.size() - 1);
+
+  std::vector<unsigned> sources;
+  for (std::size_t n = 0; n < 300; ++n)
+    sources.push_back(nodes[pick(rng)]);
+
+  auto hops = Bfs::Solve(compressed, sources, {.threads = threads});
+  ASSERT_EQ(hops.Rows(), sources.size());
+
+  for (std::size_t row = 0; row < sources.size(); ++row) {
+    auto expect = Djikstra::Solve(compressed, sources[row]);
+
+    for (const auto& to: graph.Nodes()) {
+      const float dist = expect.Distance(to);
+      const auto  hop  = hops.At(row, compressed.Index(to));
+      if (dist == compressed.DefaultValue()) {
+        ASSERT_EQ(hop, Bfs::template kUnreached<std::uint16_t>);
+      } else {
+        ASSERT_EQ(hop, dist);
+      }
+    }
+  }
+}
+
+TEST(MultiSourceBfs, Djikstra) {
+  CompareDjikstra<MultiSourceBfs>(1);
+  CompareDjikstra<MultiSourceBfs>(3);
+  CompareDjikstra<BasicMultiSourceBfs<256>>(1);
+  CompareDjikstra<BasicMultiSourceBfs<256>>(0);
+}
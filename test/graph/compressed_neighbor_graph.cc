@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "search/algorithm/bellman_ford.hh"
+#include "search/algorithm/djikstra.hh"
+#include "search/algorithm/floyd_warshall.hh"
+#include "search/graph/compressed_neighbor_graph.hh"
+#include "search/graph/neighbor_graph.hh"
+
+using namespace search;
+
+using Graph           = NeighborGraph<unsigned, float>;
+using CompressedGraph = CompressedNeighborGraph<unsigned, float>;
+
+static Graph
+MakeGraph() {
+  Graph graph;
+  graph.AddEdge(0, 1, 1.0);
+  graph.AddEdge(1, 2, 1.0);
+  graph.AddEdge(2, 3, 1.0);
+  graph.AddEdge(3, 4, 3.0);
+  graph.AddEdge(0, 3, 2.5);
+  graph.AddEdge(3, 4, 1);
+  return graph;
+}
+
+TEST(CompressedNeighborGraph, Neighbors) {
+  Graph graph;
+  graph.AddEdge(0, 1, 1.0);
+  graph.AddEdge(0, 2, 2.0);
+  graph.AddEdge(3, 0, 2.0);
+  graph.AddNode(4);
+
+  CompressedGraph compressed(graph);
+
+  ASSERT_EQ(compressed.NodeCount(), 5);
+  ASSERT_EQ(compressed.EdgeCount(), 6);
+  ASSERT_EQ(compressed.Offsets().size(), 6);
+  ASSERT_EQ(compressed.Neighbors(0).size(), 3);
+  ASSERT_EQ(compressed.Neighbors(1).size(), 1);
+  ASSERT_EQ(compressed.Neighbors(2).size(), 1);
+  ASSERT_EQ(compressed.Neighbors(3).size(), 1);
+  ASSERT_EQ(compressed.Neighbors(4).size(), 0);
+
+  float total = 0;
+  for (const auto& neigh: compressed.Neighbors(0))
+    total += neigh.edge;
+  ASSERT_FLOAT_EQ(total, 5.0);
+
+  for (const auto& neigh: compressed.Neighbors(1)) {
+    ASSERT_EQ(neigh.node, 0U);
+    ASSERT_FLOAT_EQ(neigh.edge, 1.0);
+  }
+}
+
+TEST(CompressedNeighborGraph, Index) {
+  CompressedGraph compressed(MakeGraph());
+
+  for (std::size_t i = 0; i < compressed.NodeCount(); ++i) {
+    const auto& node = compressed.Node(i);
+    ASSERT_EQ(compressed.Index(node), i);
+
+    std::size_t count = 0;
+    for (const auto& neigh: compressed.IndexNeighbors(i)) {
+      ASSERT_LT(neigh.index, compressed.NodeCount());
+      ++count;
+    }
+    ASSERT_EQ(count, compressed.Neighbors(node).size());
+  }
+}
+
+TEST(CompressedNeighborGraph, Reverse) {
+  Graph graph({.directed = true});
+  graph.AddEdge(0, 1, 1.0);
+  graph.AddEdge(0, 2, 2.0);
+  graph.AddEdge(3, 0, 3.0);
+  graph.AddEdge(1, 2, 4.0);
+
+  CompressedGraph compressed(graph);
+  auto reverse = compressed.Reverse();
+
+  ASSERT_EQ(reverse.NodeCount(), compressed.NodeCount());
+  ASSERT_EQ(reverse.EdgeCount(), compressed.EdgeCount());
+  ASSERT_EQ(reverse.Neighbors(0).size(), 1);
+  ASSERT_EQ(reverse.Neighbors(1).size(), 1);
+  ASSERT_EQ(reverse.Neighbors(2).size(), 2);
+  ASSERT_EQ(reverse.Neighbors(3).size(), 0);
+
+  for (const auto& neigh: reverse.Neighbors(0)) {
+    ASSERT_EQ(neigh.node, 3U);
+    ASSERT_FLOAT_EQ(neigh.edge, 3.0);
+  }
+
+  for (const auto& node: graph.Nodes())
+    ASSERT_EQ(reverse.Index(node), compressed.Index(node));
+}
+
+TEST(CompressedNeighborGraph, Djikstra) {
+  CompressedGraph graph(MakeGraph());
+
+  auto solution = Djikstra::Solve(graph, 0);
+
+  ASSERT_FLOAT_EQ(solution.Distance(1), 1.0);
+  ASSERT_FLOAT_EQ(solution.Distance(2), 2.0);
+  ASSERT_FLOAT_EQ(solution.Distance(3), 2.5);
+  ASSERT_FLOAT_EQ(solution.Distance(4), 3.5);
+}
+
+TEST(CompressedNeighborGraph, BellmanFord) {
+  CompressedGraph graph(MakeGraph());
+
+  auto solution = BellmanFord::Solve(graph, 0);
+
+  ASSERT_FLOAT_EQ(solution.Distance(1), 1.0);
+  ASSERT_FLOAT_EQ(solution.Distance(2), 2.0);
+  ASSERT_FLOAT_EQ(solution.Distance(3), 2.5);
+  ASSERT_FLOAT_EQ(solution.Distance(4), 3.5);
+}
+
+TEST(CompressedNeighborGraph, FloydWarshall) {
+  CompressedGraph graph(MakeGraph());
+
+  auto solution = FloydWarshall::Solve(graph);
+
+  ASSERT_FLOAT_EQ(solution.Distance(0, 4), 3.5);
+  ASSERT_FLOAT_EQ(solution.Distance(1, 4), 3.0);
+  ASSERT_FLOAT_EQ(solution.Distance(4, 0), 3.5);
+  ASSERT_FLOAT_EQ(solution.Distance(2, 1), 1.0);
+}
+
+TEST(CompressedNeighborGraph, MultiString) {
+  NeighborGraph<std::string, float> graph;
+  graph.AddEdge("0", "1", 1.0);
+  graph.AddEdge("1", "2", 1.0);
+  graph.AddEdge("2", "3", 1.0);
+  graph.AddEdge("3", "4", 3.0);
+  graph.AddEdge("0", "3", 2.5);
+  graph.AddEdge("3", "4", 1);
+
+  CompressedNeighborGraph<std::string, float> compressed(graph);
+
+  auto solution = Djikstra::Solve(compressed);
+
+  ASSERT_FLOAT_EQ(solution.Distance("0", "4"), 3.5);
+  ASSERT_FLOAT_EQ(solution.Distance("1", "4"), 3.0);
+  ASSERT_FLOAT_EQ(solution.Distance("4", "0"), 3.5);
+  ASSERT_FLOAT_EQ(solution.Distance("4", "1"), 3.0);
+}
@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+#include "search/algorithm/djikstra.hh"
+#include "search/graph/edge_list_reader.hh"
+#include "search/graph/neighbor_graph.hh"
+
+using namespace search;
+
+using Graph = NeighborGraph<unsigned, float>;
+
+static std::string
+WriteFile(const std::string& name, const std::string& contents) {
+  const std::string path = testing::TempDir() + name;
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  out << contents;
+  return path;
+}
+
+TEST(EdgeListReader, Text) {
+  const auto path = WriteFile("edge_list.txt",
+      "# from to weight\n"
+      "0 1 1.0\n"
+      "1\t2 1.0\r\n"
+      "\n"
+      "2 3 1\n"
+      "  3 4 3.0  \n"
+      "% another comment\n"
+      "0 3 2.5\n"
+      "3 4 1");
+
+  for (std::size_t threads = 1; threads <= 4; ++threads) {
+    auto graph = EdgeListReader::Read<unsigned, float>(
+        path, {}, {.threads = threads});
+
+    ASSERT_EQ(graph.NodeCount(), 5);
+    ASSERT_EQ(graph.Neighbors(0).size(), 2);
+    ASSERT_EQ(graph.Neighbors(3).size(), 4);
+    ASSERT_EQ(graph.Neighbors(4).size(), 2);
+
+    auto solution = Djikstra::Solve(graph, 0);
+    ASSERT_FLOAT_EQ(solution.Distance(1), 1.0);
+    ASSERT_FLOAT_EQ(solution.Distance(2), 2.0);
+    ASSERT_FLOAT_EQ(solution.Distance(3), 2.5);
+    ASSERT_FLOAT_EQ(solution.Distance(4), 3.5);
+  }
+}
+
+TEST(EdgeListReader, TextDirectedUnweighted) {
+  const auto path = WriteFile("edge_list_directed.txt",
+      "10 20\n"
+      "20 30\n"
+      "30 10\n");
+
+  auto graph = EdgeListReader::Read<unsigned, float>(
+      path, {.directed = true}, {.threads = 2});
+
+  ASSERT_EQ(graph.NodeCount(), 3);
+  ASSERT_EQ(graph.Nodes()[0], 10U);
+  ASSERT_EQ(graph.Neighbors(10).size(), 1);
+
+  auto solution = Djikstra::Solve(graph, 10);
+  ASSERT_FLOAT_EQ(solution.Distance(20), 1.0);
+  ASSERT_FLOAT_EQ(solution.Distance(30), 2.0);
+}
+
+TEST(EdgeListReader, TextMalformed) {
+  const auto path = WriteFile("edge_list_bad.txt",
+      "0 1 1.0\n"
+      "1 x 1.0\n");
+
+  ASSERT_THROW((EdgeListReader::Read<unsigned, float>(path)), EdgeListError);
+  ASSERT_THROW((EdgeListReader::Read<unsigned, float>(
+      testing::TempDir() + "edge_list_missing.txt")), EdgeListError);
+}
+
+TEST(EdgeListReader, Binary) {
+  struct [[gnu::packed]] Record {
+    std::uint32_t fr;
+    std::uint32_t to;
+    double        edge;
+  };
+
+  std::string contents;
+  for (std::uint32_t n = 0; n < 100; ++n) {
+    Record record = {n, n + 1, 0.5};
+    contents.append(reinterpret_cast<const char*>(&record), sizeof(record));
+  }
+
+  const auto path = WriteFile("edge_list.bin", contents);
+  auto graph = EdgeListReader::Read<std::uint32_t, double>(
+      path, {}, {.format = EdgeListFormat::BINARY, .threads = 3});
+
+  ASSERT_EQ(graph.NodeCount(), 101);
+
+  auto solution = Djikstra::Solve(graph, 0);
+  ASSERT_DOUBLE_EQ(solution.Distance(100), 50.0);
+
+  const auto truncated = WriteFile("edge_list_truncated.bin",
+                                   contents.substr(0, 30));
+  ASSERT_THROW((EdgeListReader::Read<std::uint32_t, double>(
+      truncated, {}, {.format = EdgeListFormat::BINARY})), EdgeListError);
+}
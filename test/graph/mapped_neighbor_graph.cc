@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "search/algorithm/bellman_ford.hh"
+#include "search/algorithm/djikstra.hh"
+#include "search/algorithm/floyd_warshall.hh"
+#include "search/graph/compressed_neighbor_graph.hh"
+#include "search/graph/mapped_neighbor_graph.hh"
+#include "search/graph/neighbor_graph.hh"
+
+using namespace search;
+
+using Graph       = NeighborGraph<unsigned, float>;
+using MappedGraph = MappedNeighborGraph<unsigned, float>;
+
+static Graph
+MakeGraph() {
+  Graph graph;
+  graph.AddEdge(7, 1, 1.0);
+  graph.AddEdge(1, 2, 1.0);
+  graph.AddEdge(2, 3, 1.0);
+  graph.AddEdge(3, 4, 3.0);
+  graph.AddEdge(7, 3, 2.5);
+  graph.AddEdge(3, 4, 1);
+  graph.AddNode(9);
+  return graph;
+}
+
+static std::string
+TempPath(const std::string& name) {
+  return testing::TempDir() + name;
+}
+
+TEST(MappedNeighborGraph, RoundTrip) {
+  const auto path = TempPath("mapped_round_trip.graph");
+  Graph graph = MakeGraph();
+  MappedGraph::Write(graph, path);
+
+  MappedGraph mapped(path);
+
+  ASSERT_EQ(mapped.NodeCount(), graph.NodeCount());
+  ASSERT_EQ(mapped.EdgeCount(), 12);
+  ASSERT_FLOAT_EQ(mapped.DefaultValue(), graph.DefaultValue());
+
+  for (const auto& node: graph.Nodes()) {
+    ASSERT_EQ(mapped.Index(node), graph.Index(node));
+    ASSERT_EQ(mapped.Neighbors(node).size(), graph.Neighbors(node).size());
+  }
+
+  ASSERT_THROW(mapped.Index(100), std::out_of_range);
+}
+
+TEST(MappedNeighborGraph, Solvers) {
+  const auto path = TempPath("mapped_solvers.graph");
+  MappedGraph::Write(CompressedNeighborGraph<unsigned, float>(MakeGraph()), path);
+
+  MappedGraph graph(path);
+
+  auto djikstra = Djikstra::Solve(graph, 7);
+  ASSERT_FLOAT_EQ(djikstra.Distance(1), 1.0);
+  ASSERT_FLOAT_EQ(djikstra.Distance(2), 2.0);
+  ASSERT_FLOAT_EQ(djikstra.Distance(3), 2.5);
+  ASSERT_FLOAT_EQ(djikstra.Distance(4), 3.5);
+  ASSERT_EQ(djikstra.Distance(9), graph.DefaultValue());
+
+  auto bellman_ford = BellmanFord::Solve(graph, 7);
+  ASSERT_FLOAT_EQ(bellman_ford.Distance(4), 3.5);
+
+  auto floyd_warshall = FloydWarshall::Solve(graph);
+  ASSERT_FLOAT_EQ(floyd_warshall.Distance(7, 4), 3.5);
+  ASSERT_FLOAT_EQ(floyd_warshall.Distance(4, 1), 3.0);
+}
+
+TEST(MappedNeighborGraph, Move) {
+  const auto path = TempPath("mapped_move.graph");
+  MappedGraph::Write(MakeGraph(), path);
+
+  MappedGraph graph(path);
+  MappedGraph moved(std::move(graph));
+  ASSERT_EQ(moved.NodeCount(), 6);
+  ASSERT_EQ(moved.Neighbors(3).size(), 4);
+}
+
+TEST(MappedNeighborGraph, TypeMismatch) {
+  const auto path = TempPath("mapped_mismatch.graph");
+  MappedGraph::Write(MakeGraph(), path);
+
+  using WrongGraph = MappedNeighborGraph<unsigned, int>;
+  ASSERT_THROW(WrongGraph graph(path), MappedGraphError);
+}
+
+TEST(MappedNeighborGraph, BadFile) {
+  const auto path = TempPath("mapped_bad.graph");
+  {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << std::string(256, 'x');
+  }
+
+  ASSERT_THROW(MappedGraph graph(path), MappedGraphError);
+  ASSERT_THROW(MappedGraph graph(TempPath("mapped_missing.graph")),
+               MappedGraphError);
+}
+
+TEST(MappedNeighborGraph, Corrupt) {
+  const auto path = TempPath("mapped_corrupt.graph");
+
+  // Overwrite one value of a section in a freshly written file.
+  auto corrupt = [&]<typename Type>(std::uint64_t MappedGraphHeader::* offset,
+                                    std::size_t at,
+                                    Type value) {
+    MappedGraph::Write(MakeGraph(), path);
+
+    MappedGraphHeader hdr;
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    file.read(reinterpret_cast<char*>(&hdr), sizeof(hdr));
+    file.seekp(hdr.*offset + at * sizeof(Type));
+    file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+  };
+
+  using IndexType  = MappedGraph::IndexType;
+  using OffsetType = MappedGraph::OffsetType;
+
+  // Opening only checks the header, the contents need `Validate`.
+  corrupt(&MappedGraphHeader::offsets_offset, 2, OffsetType(0));
+  ASSERT_THROW(MappedGraph(path).Validate(), MappedGraphError);
+
+  corrupt(&MappedGraphHeader::targets_offset, 3, IndexType(1000));
+  ASSERT_THROW(MappedGraph(path).Validate(), MappedGraphError);
+
+  corrupt(&MappedGraphHeader::order_offset, 0, IndexType(1000));
+  ASSERT_THROW(MappedGraph(path).Validate(), MappedGraphError);
+
+  corrupt(&MappedGraphHeader::order_offset, 1, IndexType(0));
+  ASSERT_THROW(MappedGraph(path).Validate(), MappedGraphError);
+
+  // The total edge count is in the header.
+  corrupt(&MappedGraphHeader::offsets_offset, 0, OffsetType(1));
+  ASSERT_THROW(MappedGraph graph(path), MappedGraphError);
+
+  MappedGraph::Write(MakeGraph(), path);
+  ASSERT_NO_THROW(MappedGraph(path).Validate());
+}
+
+TEST(MappedNeighborGraph, WriteFailure) {
+  // Renaming a file over a directory fails after the temporary is written.
+  const auto path = TempPath("mapped_directory.graph");
+  std::filesystem::create_directories(path);
+
+  ASSERT_THROW(MappedGraph::Write(MakeGraph(), path), MappedGraphError);
+  ASSERT_FALSE(std::filesystem::exists(path + ".tmp"));
+}
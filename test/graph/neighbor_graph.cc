@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 
+#include <string>
+
 #include "search/graph/neighbor_graph.hh"
 #include "search/matrix/dense.hh"
 #include "search/matrix/sparse_map.hh"
@@ -23,3 +25,32 @@ TEST(NeighborGraph, Test1) {
   ASSERT_EQ(graph.Neighbors(3).size(), 1);
   ASSERT_EQ(graph.Neighbors(4).size(), 0);
 }
+
+TEST(NeighborGraph, Index) {
+  using StringGraph = NeighborGraph<std::string, float>;
+  StringGraph graph;
+
+  graph.AddEdge("a", "b", 1.0);
+  graph.AddEdge("b", "c", 2.0);
+  graph.AddNode("d");
+
+  ASSERT_EQ(graph.NodeCount(), 4);
+
+  auto node_map = graph.BuildNodeMap();
+  for (const auto& node: graph.Nodes()) {
+    const auto idx = graph.Index(node);
+    ASSERT_EQ(node_map.at(node), idx);
+    ASSERT_EQ(graph.Node(idx), node);
+  }
+
+  const auto& b = graph.IndexNeighbors(graph.Index("b"));
+  ASSERT_EQ(b.size(), 2);
+  ASSERT_EQ(graph.Node(b[0].index), "a");
+  ASSERT_EQ(graph.Node(b[1].index), "c");
+  ASSERT_FLOAT_EQ(b[1].edge, 2.0);
+
+  for (const auto& neigh: graph.Neighbors("c")) {
+    ASSERT_EQ(neigh.node, "b");
+    ASSERT_FLOAT_EQ(neigh.edge, 2.0);
+  }
+}
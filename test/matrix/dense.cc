@@ -49,6 +49,15 @@ TEST(DenseMatrixRow, Alignment) {
   ASSERT_EQ(&mat.At(0, 1) - &mat.At(0, 0), 1);
 }
 
+TEST(DenseMatrixRow, Row) {
+  using Mat = DenseMatrix<unsigned, Order::ROW_MAJOR>;
+
+  Mat mat(3, 4, 1U);
+  ASSERT_EQ(mat.Row(0), &mat.At(0, 0));
+  ASSERT_EQ(mat.Row(2), &mat.At(2, 0));
+  ASSERT_EQ(mat.Row(2) + 3, &mat.At(2, 3));
+}
+
 TEST(DenseMatrixCol, Constructor) {
   using Mat = DenseMatrix<unsigned, Order::COL_MAJOR>;
 
@@ -93,3 +102,12 @@ TEST(DenseMatrixCol, Alignment) {
   Mat mat(3, 3, 1U);
   ASSERT_EQ(&mat.At(1, 0) - &mat.At(0, 0), 1);
 }
+
+TEST(DenseMatrixCol, Col) {
+  using Mat = DenseMatrix<unsigned, Order::COL_MAJOR>;
+
+  Mat mat(4, 3, 1U);
+  ASSERT_EQ(mat.Col(0), &mat.At(0, 0));
+  ASSERT_EQ(mat.Col(2), &mat.At(0, 2));
+  ASSERT_EQ(mat.Col(2) + 3, &mat.At(3, 2));
+}
@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <limits>
+
+#include "search/matrix/fixed_point.hh"
+#include "search/matrix/tropical.hh"
+
+using namespace search;
+
+TEST(FixedPoint, Encode) {
+  const FixedPoint<std::uint16_t> fixed(10.0);
+
+  ASSERT_EQ(fixed.Encode(0.0f), 0);
+  ASSERT_EQ(fixed.Encode(1.24f), 12);
+  ASSERT_EQ(fixed.Encode(1.26), 13);
+  ASSERT_EQ(fixed.Encode(7), 70);
+  ASSERT_EQ(fixed.Encode(6553.4), 65534);
+  ASSERT_FLOAT_EQ(fixed.Decode<float>(12), 1.2f);
+
+  // Anything out of range is the sentinal, which decodes to "unreached".
+  ASSERT_EQ(fixed.Encode(6553.5), fixed.kSentinal);
+  ASSERT_EQ(fixed.Encode(std::numeric_limits<float>::max()), fixed.kSentinal);
+  ASSERT_EQ(fixed.Encode(std::numeric_limits<float>::infinity()), fixed.kSentinal);
+  ASSERT_EQ(fixed.Decode<float>(fixed.kSentinal), std::numeric_limits<float>::max());
+
+  ASSERT_THROW(fixed.Encode(-0.5), FixedPointError);
+}
+
+TEST(FixedPoint, StoreDistance) {
+  ASSERT_FLOAT_EQ((StoreDistance<float>(1.5f, 10.0)), 1.5f);
+  ASSERT_EQ((StoreDistance<std::uint32_t>(1.5f, 10.0)), 15u);
+  ASSERT_EQ((StoreDistance<std::uint16_t>(std::numeric_limits<int>::max(), 1.0)),
+            std::numeric_limits<std::uint16_t>::max());
+  ASSERT_DOUBLE_EQ((StoreDistance<double>(3, 1.0)), 3.0);
+}
+
+template <typename Type>
+void
+CompareSaturate() {
+  const Type top = std::numeric_limits<Type>::max();
+
+  ASSERT_EQ(MinPlus::Add<Type>(top - 3, 2), top - 1);
+  ASSERT_EQ(MinPlus::Add<Type>(top - 3, 3), top);
+  ASSERT_EQ(MinPlus::Add<Type>(top - 3, 4), top);
+  ASSERT_EQ(MinPlus::Add<Type>(top, top), top);
+
+  for (auto level: {SimdLevel::SCALAR, SimdLevel::AVX2, SimdLevel::AVX512}) {
+    if (MinPlus::Supported() < level)
+      continue;
+
+    // Sums which overflow saturate into the sentinal and are never taken.
+    std::vector<Type> row(37, top);
+    std::vector<Type> pivot(37);
+    for (std::size_t j = 0; j < pivot.size(); ++j)
+      pivot[j] = Type(top - 1 - j);
+
+    ASSERT_TRUE(MinPlus::Row(row.data(), pivot.data(), Type(10), top, row.size(), level));
+    for (std::size_t j = 0; j < row.size(); ++j)
+      ASSERT_EQ(row[j], j < 10 ? top : Type(top - 1 - j + 10));
+  }
+}
+
+TEST(FixedPoint, Saturate) {
+  CompareSaturate<std::uint16_t>();
+  CompareSaturate<std::uint32_t>();
+  CompareSaturate<std::uint64_t>();
+}
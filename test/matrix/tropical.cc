@@ -0,0 +1,249 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "search/matrix/tropical.hh"
+
+using namespace search;
+
+template <typename Tropical, typename Type>
+void
+CompareLevels() {
+  const Type sentinal = std::numeric_limits<Type>::max();
+
+  std::mt19937 rng(41);
+  std::uniform_int_distribution<int> value(0, 100);
+  std::uniform_int_distribution<int> coin(0, 3);
+
+  for (std::size_t count: {0, 1, 7, 8, 15, 16, 17, 33, 100}) {
+    std::vector<Type> row(count);
+    std::vector<Type> pivot(count);
+    for (std::size_t j = 0; j < count; ++j) {
+      row[j]   = coin(rng) ? Type(value(rng)) : sentinal;
+      pivot[j] = coin(rng) ? Type(value(rng)) : sentinal;
+    }
+    const Type scalar = Type(value(rng));
+
+    std::vector<Type> expect = row;
+    bool changed = false;
+    for (std::size_t j = 0; j < count; ++j) {
+      if (pivot[j] == sentinal)
+        continue;
+      if (expect[j] == sentinal || Tropical::Better(Type(pivot[j] + scalar), expect[j])) {
+        expect[j] = pivot[j] + scalar;
+        changed = true;
+      }
+    }
+
+    for (auto level: {SimdLevel::SCALAR, SimdLevel::AVX2, SimdLevel::AVX512}) {
+      if (Tropical::Supported() < level)
+        continue;
+
+      std::vector<Type> actual = row;
+      ASSERT_EQ(changed, Tropical::Row(
+          actual.data(), pivot.data(), scalar, sentinal, count, level));
+      ASSERT_EQ(expect, actual);
+
+      // A sentinal scalar changes nothing.
+      ASSERT_FALSE(Tropical::Row(
+          actual.data(), pivot.data(), sentinal, sentinal, count, level));
+      ASSERT_EQ(expect, actual);
+
+      // The pivot may be the row itself, which never gets shorter with a
+      // non-negative scalar.
+      if constexpr (Tropical::semiring == Semiring::MIN_PLUS) {
+        ASSERT_FALSE(Tropical::Row(
+            actual.data(), actual.data(), scalar, sentinal, count, level));
+        ASSERT_EQ(expect, actual);
+      }
+    }
+  }
+}
+
+TEST(MinPlus, Float) {
+  CompareLevels<MinPlus, float>();
+}
+
+TEST(MinPlus, Double) {
+  CompareLevels<MinPlus, double>();
+}
+
+TEST(MinPlus, Int32) {
+  CompareLevels<MinPlus, std::int32_t>();
+}
+
+TEST(MinPlus, Uint32) {
+  CompareLevels<MinPlus, std::uint32_t>();
+}
+
+TEST(MinPlus, Generic) {
+  CompareLevels<MinPlus, std::uint16_t>();
+  CompareLevels<MinPlus, std::int64_t>();
+}
+
+TEST(MinPlus, Negative) {
+  // A sentinal which is not the largest value still acts as +infinity.
+  const std::int32_t sentinal = -1;
+  for (auto level: {SimdLevel::SCALAR, SimdLevel::AVX2, SimdLevel::AVX512}) {
+    if (MinPlus::Supported() < level)
+      continue;
+
+    std::vector<std::int32_t> row(19, sentinal);
+    std::vector<std::int32_t> pivot(19, 5);
+    pivot[3] = sentinal;
+    row[4]   = 2;
+
+    ASSERT_TRUE(MinPlus::Row(row.data(), pivot.data(), 1, sentinal, row.size(), level));
+    for (std::size_t j = 0; j < row.size(); ++j) {
+      if (j == 3) {
+        ASSERT_EQ(row[j], sentinal);
+      } else if (j == 4) {
+        ASSERT_EQ(row[j], 2);
+      } else {
+        ASSERT_EQ(row[j], 6);
+      }
+    }
+  }
+}
+
+TEST(MaxPlus, Levels) {
+  CompareLevels<MaxPlus, float>();
+  CompareLevels<MaxPlus, double>();
+  CompareLevels<MaxPlus, std::int32_t>();
+  CompareLevels<MaxPlus, std::uint32_t>();
+  CompareLevels<MaxPlus, std::int64_t>();
+}
+
+TEST(MaxPlus, Negative) {
+  // The lowest value is the usual sentinal, standing for -infinity.
+  const std::int32_t sentinal = std::numeric_limits<std::int32_t>::min();
+  for (auto level: {SimdLevel::SCALAR, SimdLevel::AVX2, SimdLevel::AVX512}) {
+    if (MaxPlus::Supported() < level)
+      continue;
+
+    std::vector<std::int32_t> row(19, sentinal);
+    std::vector<std::int32_t> pivot(19, -5);
+    pivot[3] = sentinal;
+    row[4]   = 2;
+
+    ASSERT_TRUE(MaxPlus::Row(row.data(), pivot.data(), 1, sentinal, row.size(), level));
+    for (std::size_t j = 0; j < row.size(); ++j) {
+      if (j == 3) {
+        ASSERT_EQ(row[j], sentinal);
+      } else if (j == 4) {
+        ASSERT_EQ(row[j], 2);
+      } else {
+        ASSERT_EQ(row[j], -4);
+      }
+    }
+  }
+}
+
+template <typename Tropical, typename Type>
+DenseMatrix<Type>
+NaiveMultiply(const DenseMatrix<Type>& lhs, const DenseMatrix<Type>& rhs) {
+  const Type sentinal = lhs.DefaultValue();
+  DenseMatrix<Type> out(lhs.Rows(), rhs.Cols(), sentinal);
+
+  for (std::size_t i = 0; i < lhs.Rows(); ++i) {
+    for (std::size_t j = 0; j < rhs.Cols(); ++j) {
+      for (std::size_t k = 0; k < lhs.Cols(); ++k) {
+        if (lhs.Get(i, k) == sentinal || rhs.Get(k, j) == sentinal)
+          continue;
+
+        const Type sum = lhs.Get(i, k) + rhs.Get(k, j);
+        if (out.Get(i, j) == sentinal || Tropical::Better(sum, out.Get(i, j)))
+          out.At(i, j) = sum;
+      }
+    }
+  }
+
+  return out;
+}
+
+template <typename Type>
+DenseMatrix<Type>
+RandomMatrix(std::size_t rows, std::size_t cols, Type sentinal, std::mt19937& rng) {
+  std::uniform_int_distribution<int> value(-20, 50);
+  std::uniform_int_distribution<int> coin(0, 2);
+
+  DenseMatrix<Type> matrix(rows, cols, sentinal);
+  for (std::size_t i = 0; i < rows; ++i)
+    for (std::size_t j = 0; j < cols; ++j)
+      if (coin(rng))
+        matrix.At(i, j) = Type(value(rng));
+
+  return matrix;
+}
+
+TEST(Tropical, Multiply) {
+  std::mt19937 rng(43);
+
+  auto lhs = RandomMatrix<float>(37, 53, std::numeric_limits<float>::max(), rng);
+  auto rhs = RandomMatrix<float>(53, 29, std::numeric_limits<float>::max(), rng);
+  const auto expect = NaiveMultiply<MinPlus>(lhs, rhs);
+
+  for (std::size_t block: {0, 1, 8, 16, 256}) {
+    for (std::size_t threads: {1, 3, 0}) {
+      const auto actual = MinPlus::Multiply(lhs, rhs, {.block = block, .threads = threads});
+      ASSERT_EQ(actual.Rows(), expect.Rows());
+      ASSERT_EQ(actual.Cols(), expect.Cols());
+      for (std::size_t i = 0; i < expect.Rows(); ++i)
+        for (std::size_t j = 0; j < expect.Cols(); ++j)
+          ASSERT_EQ(actual.Get(i, j), expect.Get(i, j));
+    }
+  }
+
+  const std::int32_t lowest = std::numeric_limits<std::int32_t>::min();
+  auto max_lhs = RandomMatrix<std::int32_t>(41, 23, lowest, rng);
+  auto max_rhs = RandomMatrix<std::int32_t>(23, 67, lowest, rng);
+  const auto max_expect = NaiveMultiply<MaxPlus>(max_lhs, max_rhs);
+  const auto max_actual = MaxPlus::Multiply(max_lhs, max_rhs, {.block = 16, .threads = 2});
+  for (std::size_t i = 0; i < max_expect.Rows(); ++i)
+    for (std::size_t j = 0; j < max_expect.Cols(); ++j)
+      ASSERT_EQ(max_actual.Get(i, j), max_expect.Get(i, j));
+}
+
+TEST(Tropical, Power) {
+  // A directed ring 0 -> 1 -> ... -> 5 -> 0 of unit edges, with a shortcut
+  // 0 -> 3 of 10.
+  const int sentinal = std::numeric_limits<int>::max();
+  DenseMatrix<int> ring(6, 6, sentinal);
+  for (std::size_t idx = 0; idx < 6; ++idx)
+    ring.At(idx, (idx + 1) % 6) = 1;
+  ring.At(0, 3) = 10;
+
+  const auto zero = MinPlus::Power(ring, 0);
+  for (std::size_t i = 0; i < 6; ++i)
+    for (std::size_t j = 0; j < 6; ++j)
+      ASSERT_EQ(zero.Get(i, j), i == j ? 0 : sentinal);
+
+  // Paths of exactly `hops` edges.
+  for (std::size_t hops = 1; hops < 8; ++hops) {
+    const auto power = MinPlus::Power(ring, hops, {.block = 4});
+    ASSERT_EQ(power.Get(0, hops % 6), int(hops));
+
+    // The shortcut is the only way to cover 3 nodes in a single hop.
+    if (hops == 1) {
+      ASSERT_EQ(power.Get(0, 3), 10);
+    }
+  }
+
+  // With a zero diagonal, paths of at most `hops` edges.
+  for (std::size_t idx = 0; idx < 6; ++idx)
+    ring.At(idx, idx) = 0;
+
+  const auto two = MinPlus::Power(ring, 2);
+  ASSERT_EQ(two.Get(0, 1), 1);
+  ASSERT_EQ(two.Get(0, 2), 2);
+  ASSERT_EQ(two.Get(0, 3), 10);
+  ASSERT_EQ(two.Get(0, 4), 11);
+  ASSERT_EQ(two.Get(0, 5), sentinal);
+
+  const auto five = MinPlus::Power(ring, 5);
+  ASSERT_EQ(five.Get(0, 5), 5);
+  ASSERT_EQ(five.Get(0, 3), 3);
+}